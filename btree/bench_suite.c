@@ -0,0 +1,173 @@
+/*
+ * Škálovatelné měření operací binárního vyhledávacího stromu.
+ *
+ * Pro každé rozdělení klíčů (rovnoměrné, vzestupné, sestupné a Zipfovo)
+ * a každou velikost od nejmenší po největší, vždy desetinásobnou, se změří
+ * vložení, vyhledání, průchod inorder a odstranění size klíčů, se
+ * sestavením s exa.c (-DEXA) navíc vyvážení a letter_count nad textem
+ * o size znacích. Klíčů typu char je nejvýše 256, velikost je tedy počet
+ * operací a strom obsahuje nejvýše 256 různých klíčů.
+ *
+ * Program se spouští jako bench [největší velikost [nejmenší velikost]],
+ * výchozí rozsah je 10^2 až 10^8. Výstupem jsou řádky CSV ve tvaru
+ * engine,operace,rozdělení,velikost,počet operací,ns/op,op/s,RSS v kB.
+ *
+ * Iterativní průchody ukládají levou hranu stromu na zásobník o MAXSTACK
+ * položkách (iter/stack.h). Při sestavení s -DBENCH_ITER se proto průchod
+ * a vyvážení stromu, který by zásobník přeplnil, nahradí zprávou na
+ * standardní chybový výstup, místo aby vypsaly čas neúplného průchodu.
+ * Průchod, který nenavštíví všechny uzly stromu, program ukončí s chybou.
+ *
+ * Je-li nastavena proměnná prostředí BENCH_PERF, každý řádek pokračuje
+ * počty cyklů, instrukcí, výpadků L1D a LLC, chybných předpovědí skoků
+ * a výpadků DTLB na operaci. Čítače, které systém neposkytuje, zůstanou
+ * prázdné.
+ */
+
+#include "btree.h"
+#include "bench_util.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef BENCH_ITER
+#include "iter/stack.h"
+#endif
+
+#ifndef BENCH_BST
+#define BENCH_BST "btree"
+#endif
+
+#ifdef EXA
+#define BENCH_TRAVERSALS "traverse and balance"
+#else
+#define BENCH_TRAVERSALS "traverse"
+#endif
+
+volatile long long sink = 0;
+
+// Function to get the tree key of the rank, ranks follow the order of keys
+char rank_key(unsigned char rank) {
+  return (char)(rank + CHAR_MIN);
+}
+
+// Function to get the most nodes bst_inorder keeps on its stack, the root waits there during its left subtree
+int inorder_depth(bst_node_t *tree) {
+  if (!tree) return 0;
+  int left = 1 + inorder_depth(tree->left);
+  int right = inorder_depth(tree->right);
+  return left > right ? left : right;
+}
+
+void bench_size(bench_distribution_t distribution, long long size,
+                unsigned char *ranks) {
+  bst_node_t *tree;
+  bst_init(&tree);
+  long long start = bench_start();
+  for (long long i = 0; i < size; i++) {
+    bst_insert(&tree, rank_key(ranks[i]), (int)i);
+  }
+  bench_report_sized(BENCH_BST, "insert", distribution, size, size,
+                     bench_now_ns() - start);
+
+  start = bench_start();
+  for (long long i = 0; i < size; i++) {
+    int value;
+    if (bst_search(tree, rank_key(ranks[size - 1 - i]), &value)) {
+      sink += value;
+    }
+  }
+  bench_report_sized(BENCH_BST, "search", distribution, size, size,
+                     bench_now_ns() - start);
+
+  bool traversable = true;
+#ifdef MAXSTACK
+  int depth = inorder_depth(tree);
+  traversable = depth <= MAXSTACK;
+  if (!traversable) {
+    fprintf(stderr, "%s: skipped %s of %s %lld, inorder needs %d of %d stack items\n",
+            BENCH_BST, BENCH_TRAVERSALS, bench_distribution_names[distribution],
+            size, depth, MAXSTACK);
+  }
+#endif
+
+  if (traversable) {
+    // the whole tree is traversed until size nodes are visited
+    bst_items_t items = {NULL, 0, 0};
+    long long visited = 0;
+    start = bench_start();
+    while (visited < size) {
+      items.size = 0;
+      bst_inorder(tree, &items);
+      if (items.size != bst_size(tree)) {
+        fprintf(stderr, "%s: traverse visited %d of %d nodes\n", BENCH_BST,
+                items.size, bst_size(tree));
+        exit(1);
+      }
+      visited += items.size;
+      sink += items.nodes[0]->value;
+    }
+    bench_report_sized(BENCH_BST, "traverse", distribution, size, visited,
+                       bench_now_ns() - start);
+    free(items.nodes);
+
+#ifdef EXA
+    long long balances = size / 256 + 1;
+    start = bench_start();
+    for (long long i = 0; i < balances; i++) {
+      bst_balance(&tree);
+    }
+    bench_report_sized(BENCH_BST, "balance", distribution, size, balances,
+                       bench_now_ns() - start);
+#endif
+  }
+
+  start = bench_start();
+  for (long long i = 0; i < size; i++) {
+    bst_delete(&tree, rank_key(ranks[i]));
+  }
+  bench_report_sized(BENCH_BST, "delete", distribution, size, size,
+                     bench_now_ns() - start);
+  bst_dispose(&tree);
+
+#ifdef EXA
+  // ranks become printable text in place, they are not needed any more
+  char *text = (char *)ranks;
+  for (long long i = 0; i < size; i++) {
+    text[i] = (char)(' ' + ranks[i] % 95);
+  }
+  text[size] = '\0';
+  start = bench_start();
+  letter_count(&tree, text);
+  bench_report_sized(BENCH_BST, "letter_count", distribution, size, size,
+                     bench_now_ns() - start);
+  sink += bst_size(tree);
+  bst_dispose(&tree);
+#endif
+}
+
+int main(int argc, char *argv[]) {
+  long long max_size = argc > 1 ? atoll(argv[1]) : 100000000;
+  long long min_size = argc > 2 ? atoll(argv[2]) : 100;
+  if (min_size < 1) min_size = 1;
+  if (max_size < min_size) max_size = min_size;
+
+  unsigned char *ranks = malloc(max_size + 1);
+  if (!ranks) return 1;
+
+  bench_report_header();
+  for (int distribution = 0; distribution < BENCH_DISTRIBUTIONS; distribution++) {
+    unsigned state = 2463534242u;
+    for (long long size = min_size; size <= max_size; size *= 10) {
+      if (!bench_fill_ranks(ranks, size, distribution, &state)) {
+        free(ranks);
+        return 1;
+      }
+      bench_size(distribution, size, ranks);
+    }
+  }
+
+  free(ranks);
+  return 0;
+}
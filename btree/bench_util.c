@@ -0,0 +1,263 @@
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+// Hardware events counted in each measured region, in the order of the CSV columns
+#define BENCH_PERF_EVENTS 6
+
+#ifdef __linux__
+#define BENCH_CACHE_MISS(cache)                                                \
+  (PERF_COUNT_HW_CACHE_##cache | PERF_COUNT_HW_CACHE_OP_READ << 8 |            \
+   PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+
+const struct {
+  unsigned type;
+  unsigned long long config;
+} bench_perf_events[BENCH_PERF_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, BENCH_CACHE_MISS(L1D)},
+    {PERF_TYPE_HW_CACHE, BENCH_CACHE_MISS(LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, BENCH_CACHE_MISS(DTLB)},
+};
+#endif
+
+// Counter descriptors, -1 for events the machine does not count
+int bench_perf_fds[BENCH_PERF_EVENTS];
+
+// 0 before the first use, 1 without counters, 2 with counters
+int bench_perf_state = 0;
+
+const char *bench_distribution_names[BENCH_DISTRIBUTIONS] = {"uniform", "sorted",
+                                                             "reverse", "zipf"};
+
+long long bench_now_ns() {
+  struct timespec now;
+  timespec_get(&now, TIME_UTC);
+  return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+// Function to open the counters when the BENCH_PERF environment variable is set
+bool bench_perf_enabled() {
+  if (bench_perf_state == 0) {
+    const char *perf = getenv("BENCH_PERF");
+    bench_perf_state = perf != NULL && *perf != '\0' && strcmp(perf, "0") != 0 ? 2 : 1;
+    if (bench_perf_state == 1) {
+      return false;
+    }
+
+    int opened = 0;
+    for (int i = 0; i < BENCH_PERF_EVENTS; i++) {
+      bench_perf_fds[i] = -1;
+#ifdef __linux__
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = bench_perf_events[i].type;
+      attr.config = bench_perf_events[i].config;
+      attr.read_format =
+          PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.disabled = 1;
+      attr.inherit = 1; // threads started in the region are counted too
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      bench_perf_fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+      opened += bench_perf_fds[i] >= 0;
+    }
+    if (opened == 0) {
+      fprintf(stderr, "bench: hardware counters are not available\n");
+    }
+  }
+  return bench_perf_state == 2;
+}
+
+// Function to stop the counters, they are read before the report does any work of its own
+void bench_perf_stop(double *values) {
+  for (int i = 0; i < BENCH_PERF_EVENTS; i++) {
+    values[i] = -1;
+  }
+  if (!bench_perf_enabled()) {
+    return;
+  }
+#ifdef __linux__
+  for (int i = 0; i < BENCH_PERF_EVENTS; i++) {
+    if (bench_perf_fds[i] >= 0) {
+      ioctl(bench_perf_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for (int i = 0; i < BENCH_PERF_EVENTS; i++) {
+    // value, time enabled and time running, the counter may share the hardware
+    unsigned long long value[3];
+    if (bench_perf_fds[i] >= 0 &&
+        read(bench_perf_fds[i], value, sizeof(value)) == sizeof(value) &&
+        value[2] > 0) {
+      values[i] = (double)value[0] * value[1] / value[2];
+    }
+  }
+#endif
+}
+
+// Function to print the counter values per operation as CSV columns, unknown values stay empty
+void bench_perf_report(const double *values, long long ops) {
+  if (!bench_perf_enabled()) {
+    return;
+  }
+  for (int i = 0; i < BENCH_PERF_EVENTS; i++) {
+    if (values[i] < 0 || ops <= 0) {
+      printf(",");
+    } else {
+      printf(",%.2f", values[i] / ops);
+    }
+  }
+}
+
+long long bench_start() {
+  if (bench_perf_enabled()) {
+    for (int i = 0; i < BENCH_PERF_EVENTS; i++) {
+#ifdef __linux__
+      if (bench_perf_fds[i] >= 0) {
+        ioctl(bench_perf_fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(bench_perf_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+    }
+  }
+  return bench_now_ns();
+}
+
+const char *bench_perf_columns() {
+  return bench_perf_enabled()
+             ? ",cycles_per_op,instructions_per_op,l1d_misses_per_op,"
+               "llc_misses_per_op,branch_misses_per_op,dtlb_misses_per_op"
+             : "";
+}
+
+unsigned bench_random(unsigned *state) {
+  unsigned x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+bool bench_zipf_init(bench_zipf_t *zipf, int size) {
+  zipf->cdf = malloc(sizeof(double) * size);
+  zipf->size = zipf->cdf ? size : 0;
+  if (!zipf->cdf) return false;
+
+  double total = 0;
+  for (int i = 0; i < size; i++) {
+    total += 1.0 / (i + 1);
+    zipf->cdf[i] = total;
+  }
+  for (int i = 0; i < size; i++) {
+    zipf->cdf[i] /= total;
+  }
+  return true;
+}
+
+int bench_zipf(bench_zipf_t *zipf, unsigned *state) {
+  double u = bench_random(state) / 4294967296.0;
+  int lo = 0, hi = zipf->size - 1;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (zipf->cdf[mid] <= u) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+void bench_zipf_dispose(bench_zipf_t *zipf) {
+  free(zipf->cdf);
+  zipf->cdf = NULL;
+  zipf->size = 0;
+}
+
+void bench_report(const char *engine, const char *operation, long long ops,
+                  long long elapsed_ns) {
+  double counters[BENCH_PERF_EVENTS];
+  bench_perf_stop(counters);
+  double ns_per_op = ops > 0 ? (double)elapsed_ns / ops : 0;
+  double ops_per_s = elapsed_ns > 0 ? ops * 1e9 / elapsed_ns : 0;
+  printf("%s,%s,%lld,%.2f,%.0f", engine, operation, ops, ns_per_op, ops_per_s);
+  bench_perf_report(counters, ops);
+  printf("\n");
+}
+
+bool bench_fill_ranks(unsigned char *ranks, long long size,
+                      bench_distribution_t distribution, unsigned *state) {
+  bench_zipf_t zipf = {NULL, 0};
+  if (distribution == BENCH_ZIPF && !bench_zipf_init(&zipf, 256)) {
+    return false;
+  }
+  for (long long i = 0; i < size; i++) {
+    switch (distribution) {
+    case BENCH_UNIFORM:
+      ranks[i] = (unsigned char)bench_random(state);
+      break;
+    case BENCH_SORTED:
+      ranks[i] = (unsigned char)(i * 256 / size);
+      break;
+    case BENCH_REVERSE:
+      ranks[i] = (unsigned char)(255 - i * 256 / size);
+      break;
+    default:
+      // 167 is odd, so multiplying by it permutes the ranks
+      ranks[i] = (unsigned char)(bench_zipf(&zipf, state) * 167);
+      break;
+    }
+  }
+  bench_zipf_dispose(&zipf);
+  return true;
+}
+
+long long bench_rss_kb() {
+  FILE *statm = fopen("/proc/self/statm", "r");
+  long long pages = 0, resident = 0;
+  if (statm == NULL) {
+    return 0; // resident size is not known outside Linux
+  }
+  if (fscanf(statm, "%lld %lld", &pages, &resident) != 2) {
+    resident = 0;
+  }
+  fclose(statm);
+  return resident * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+void bench_report_header() {
+  printf("engine,operation,distribution,size,ops,ns_per_op,ops_per_s,rss_kb%s\n",
+         bench_perf_columns());
+}
+
+void bench_report_sized(const char *engine, const char *operation,
+                        bench_distribution_t distribution, long long size,
+                        long long ops, long long elapsed_ns) {
+  double counters[BENCH_PERF_EVENTS];
+  bench_perf_stop(counters);
+  double ns_per_op = ops > 0 ? (double)elapsed_ns / ops : 0;
+  double ops_per_s = elapsed_ns > 0 ? ops * 1e9 / elapsed_ns : 0;
+  printf("%s,%s,%s,%lld,%lld,%.2f,%.0f,%lld", engine, operation,
+         bench_distribution_names[distribution], size, ops, ns_per_op,
+         ops_per_s, bench_rss_kb());
+  bench_perf_report(counters, ops);
+  printf("\n");
+  fflush(stdout);
+}
@@ -0,0 +1,49 @@
+#ifndef IAL_BTREE_BENCH_UTIL_H
+#define IAL_BTREE_BENCH_UTIL_H
+
+#include <stdbool.h>
+
+long long bench_now_ns();
+
+// Start of a measured region, returns bench_now_ns() after starting the
+// hardware counters when the BENCH_PERF environment variable is set; the
+// next bench_report or bench_report_sized stops them and prints them per op
+long long bench_start();
+unsigned bench_random(unsigned *state);
+
+// Zipf distribution over ranks 0..size-1 with exponent 1
+typedef struct bench_zipf {
+  double *cdf; // cumulative probability of ranks up to the index, size items
+  int size;    // number of ranks
+} bench_zipf_t;
+
+// Returns false if the cdf cannot be allocated, bench_zipf_dispose frees it
+bool bench_zipf_init(bench_zipf_t *zipf, int size);
+int bench_zipf(bench_zipf_t *zipf, unsigned *state);
+void bench_zipf_dispose(bench_zipf_t *zipf);
+
+void bench_report(const char *engine, const char *operation, long long ops,
+                  long long elapsed_ns);
+
+// Order of the key ranks generated by bench_fill_ranks
+typedef enum bench_distribution {
+  BENCH_UNIFORM,   // independent uniform ranks
+  BENCH_SORTED,    // ascending ranks, each repeated size / 256 times
+  BENCH_REVERSE,   // descending ranks, each repeated size / 256 times
+  BENCH_ZIPF,      // Zipf ranks with the hot ranks spread over the key range
+  BENCH_DISTRIBUTIONS
+} bench_distribution_t;
+
+extern const char *bench_distribution_names[BENCH_DISTRIBUTIONS];
+
+// Returns false if the Zipf ranks cannot be allocated
+bool bench_fill_ranks(unsigned char *ranks, long long size,
+                      bench_distribution_t distribution, unsigned *state);
+long long bench_rss_kb();
+const char *bench_perf_columns(); // CSV header of the counter columns, empty without BENCH_PERF
+void bench_report_header();
+void bench_report_sized(const char *engine, const char *operation,
+                        bench_distribution_t distribution, long long size,
+                        long long ops, long long elapsed_ns);
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Porovnání B+ stromu a mapy přímo indexované klíčem s binárním
+ * vyhledávacím stromem.
+ *
+ * Program se sestavuje zvlášť s rekurzivní a iterativní variantou
+ * binárního stromu (make bench). Výstupem jsou řádky CSV ve tvaru
+ * engine,operace,počet operací,ns/op,op/s.
+ *
+ * S proměnnou prostředí BENCH_PERF přibudou sloupce hardwarových čítačů
+ * na operaci, podle výpadků cache a TLB lze porovnat uložení uzlů
+ * v ukazatelích a v poli.
+ */
+
+#include "bplus.h"
+#include "../btree.h"
+#include "../bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef BENCH_BST
+#define BENCH_BST "btree"
+#endif
+
+volatile long long sink = 0;
+
+void sum_visitor(char key, int value, void *data) {
+  *(long long *)data += value;
+}
+
+void bench_bst(const char *keys, int n) {
+  bst_node_t *tree;
+  bst_init(&tree);
+  long long start = bench_start();
+  for (int i = 0; i < n; i++) {
+    bst_insert(&tree, keys[i], i);
+  }
+  bench_report(BENCH_BST, "insert", n, bench_now_ns() - start);
+
+  start = bench_start();
+  for (int i = 0; i < n; i++) {
+    int value;
+    if (bst_search(tree, keys[n - 1 - i], &value)) {
+      sink += value;
+    }
+  }
+  bench_report(BENCH_BST, "search", n, bench_now_ns() - start);
+
+  int scans = n / 64 + 1;
+  start = bench_start();
+  for (int i = 0; i < scans; i++) {
+    char lo = keys[i], hi = lo > 95 ? 127 : lo + 32;
+    bst_items_t items = {NULL, 0, 0};
+    bst_inorder(tree, &items);
+    for (int j = 0; j < items.size; j++) {
+      if (items.nodes[j]->key >= lo && items.nodes[j]->key <= hi) {
+        sink += items.nodes[j]->value;
+      }
+    }
+    free(items.nodes);
+  }
+  bench_report(BENCH_BST, "range", scans, bench_now_ns() - start);
+
+  start = bench_start();
+  for (int i = 0; i < n; i++) {
+    bst_delete(&tree, keys[i]);
+  }
+  bench_report(BENCH_BST, "delete", n, bench_now_ns() - start);
+  bst_dispose(&tree);
+}
+
+void bench_bpt(const char *keys, int n) {
+  bpt_node_t *tree;
+  bpt_init(&tree);
+  long long start = bench_start();
+  for (int i = 0; i < n; i++) {
+    bpt_insert(&tree, keys[i], i);
+  }
+  bench_report("bplus", "insert", n, bench_now_ns() - start);
+
+  start = bench_start();
+  for (int i = 0; i < n; i++) {
+    int value;
+    if (bpt_search(tree, keys[n - 1 - i], &value)) {
+      sink += value;
+    }
+  }
+  bench_report("bplus", "search", n, bench_now_ns() - start);
+
+  int scans = n / 64 + 1;
+  start = bench_start();
+  for (int i = 0; i < scans; i++) {
+    char lo = keys[i], hi = lo > 95 ? 127 : lo + 32;
+    long long sum = 0;
+    bpt_range(tree, lo, hi, sum_visitor, &sum);
+    sink += sum;
+  }
+  bench_report("bplus", "range", scans, bench_now_ns() - start);
+
+  start = bench_start();
+  for (int i = 0; i < n; i++) {
+    bpt_delete(&tree, keys[i]);
+  }
+  bench_report("bplus", "delete", n, bench_now_ns() - start);
+  bpt_dispose(&tree);
+
+  char sorted_keys[256];
+  int sorted_values[256];
+  for (int i = 0; i < 256; i++) {
+    sorted_keys[i] = (char)(i - 128);
+    sorted_values[i] = i;
+  }
+  int loads = n / 256 + 1;
+  start = bench_start();
+  for (int i = 0; i < loads; i++) {
+    bpt_bulk_load(&tree, sorted_keys, sorted_values, 256);
+    bpt_dispose(&tree);
+  }
+  bench_report("bplus", "bulk_load_256", loads, bench_now_ns() - start);
+}
+
+void bench_dense(const char *keys, int n) {
+  bst_dense_t dense;
+  bst_dense_init(&dense);
+  long long start = bench_start();
+  for (int i = 0; i < n; i++) {
+    bst_dense_insert(&dense, keys[i], i);
+  }
+  bench_report("dense", "insert", n, bench_now_ns() - start);
+
+  start = bench_start();
+  for (int i = 0; i < n; i++) {
+    int value;
+    if (bst_dense_search(&dense, keys[n - 1 - i], &value)) {
+      sink += value;
+    }
+  }
+  bench_report("dense", "search", n, bench_now_ns() - start);
+
+  int scans = n / 64 + 1;
+  start = bench_start();
+  for (int i = 0; i < scans; i++) {
+    char lo = keys[i], hi = lo > 95 ? 127 : lo + 32;
+    long long sum = 0;
+    bst_dense_range(&dense, lo, hi, sum_visitor, &sum);
+    sink += sum;
+  }
+  bench_report("dense", "range", scans, bench_now_ns() - start);
+
+  start = bench_start();
+  for (int i = 0; i < n; i++) {
+    bst_dense_delete(&dense, keys[i]);
+  }
+  bench_report("dense", "delete", n, bench_now_ns() - start);
+}
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  char *keys = malloc(n > 0 ? n : 1);
+  if (!keys) return 1;
+
+  unsigned state = 2463534242u;
+  for (int i = 0; i < n; i++) {
+    keys[i] = (char)bench_random(&state);
+  }
+
+  printf("engine,operation,ops,ns_per_op,ops_per_s%s\n", bench_perf_columns());
+  bench_bst(keys, n);
+  bench_bpt(keys, n);
+  bench_dense(keys, n);
+
+  free(keys);
+  return 0;
+}
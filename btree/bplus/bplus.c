@@ -0,0 +1,420 @@
+/*
+ * B+ strom s vysokým stupněm větvení
+ *
+ * Uzel obsahuje až BPT_ORDER klíčů, hodnoty jsou uloženy pouze v listech a
+ * listy jsou zřetězeny pro průchod rozsahem. Klíče uzlu zabírají jeden
+ * cache řádek, pozice klíče v uzlu se hledá SIMD porovnáním 16 klíčů naráz.
+ *
+ * Vkládání i mazání pracuje shora dolů: plný uzel se rozdělí a uzel
+ * s minimálním počtem klíčů se doplní dříve, než do něj funkce sestoupí,
+ * takže se žádná změna nemusí šířit zpět ke kořeni.
+ */
+
+#include "bplus.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) && CHAR_MIN < 0
+#include <emmintrin.h>
+#define BPT_SIMD 1
+#endif
+
+_Static_assert(BPT_ORDER % 16 == 0, "BPT_ORDER must be a multiple of 16");
+
+// Minimal number of keys in a node other than root (a split full node keeps at least this many)
+#define BPT_MIN (BPT_ORDER / 2 - 1)
+
+// Function to count keys of the node less than key, or less or equal to key when equal is set
+int countBelow(bpt_node_t *node, char key, bool equal)
+{
+  int count = 0;
+#ifdef BPT_SIMD
+  __m128i needle = _mm_set1_epi8(key);
+
+  for (int i = 0; i < node->count; i += 16)
+  {
+    __m128i block = _mm_loadu_si128((const __m128i *)(node->keys + i));
+    unsigned mask = equal
+      ? ~_mm_movemask_epi8(_mm_cmpgt_epi8(block, needle)) & 0xFFFF  // keys <= key
+      : _mm_movemask_epi8(_mm_cmplt_epi8(block, needle));           // keys < key
+
+    if (node->count - i < 16)
+    {
+      mask &= (1u << (node->count - i)) - 1;                        // we ignore unused slots
+    }
+    count += __builtin_popcount(mask);                               // keys are sorted, so the count is the position
+  }
+#else
+  while (count < node->count && (node->keys[count] < key || (equal && node->keys[count] == key)))
+  {
+    count++;
+  }
+#endif
+  return count;
+}
+
+// Function to allocate an empty node
+bpt_node_t *newNode(bool leaf)
+{
+  bpt_node_t *node = calloc(1, sizeof(bpt_node_t));  // zeroed keys keep SIMD loads defined
+  if (node) node->leaf = leaf;
+  return node;
+}
+
+// Function to split the full child i of parent into two nodes, returns false when allocation fails
+bool splitChild(bpt_node_t *parent, int i)
+{
+  bpt_node_t *child = parent->children[i];
+  bpt_node_t *right = newNode(child->leaf);
+  if (!right) return false;
+
+  char separator;
+  int half = BPT_ORDER / 2;
+
+  if (child->leaf)
+  {
+    right->count = BPT_ORDER - half;                                  // right leaf takes the upper half
+    memcpy(right->keys, child->keys + half, right->count);
+    memcpy(right->values, child->values + half, right->count * sizeof(int));
+    right->next = child->next;                                        // we keep the leaf chain
+    child->next = right;
+    separator = right->keys[0];                                       // separator is the first key of the right leaf
+  }
+  else
+  {
+    right->count = BPT_ORDER - half - 1;                              // middle key moves up to the parent
+    memcpy(right->keys, child->keys + half + 1, right->count);
+    memcpy(right->children, child->children + half + 1, (right->count + 1) * sizeof(bpt_node_t *));
+    separator = child->keys[half];
+  }
+  child->count = half;
+
+  memmove(parent->keys + i + 1, parent->keys + i, parent->count - i);  // we make room in the parent
+  memmove(parent->children + i + 2, parent->children + i + 1, (parent->count - i) * sizeof(bpt_node_t *));
+  parent->keys[i] = separator;
+  parent->children[i + 1] = right;
+  parent->count++;
+
+  return true;
+}
+
+// Function to make child i of parent hold more than BPT_MIN keys by borrowing from or merging with a sibling
+void fillChild(bpt_node_t *parent, int i)
+{
+  bpt_node_t *child = parent->children[i];
+  bpt_node_t *left = i > 0 ? parent->children[i - 1] : NULL;
+  bpt_node_t *right = i < parent->count ? parent->children[i + 1] : NULL;
+
+  if (left && left->count > BPT_MIN)                                  // we borrow the greatest key of the left sibling
+  {
+    memmove(child->keys + 1, child->keys, child->count);
+    if (child->leaf)
+    {
+      memmove(child->values + 1, child->values, child->count * sizeof(int));
+      child->keys[0] = left->keys[left->count - 1];
+      child->values[0] = left->values[left->count - 1];
+      parent->keys[i - 1] = child->keys[0];
+    }
+    else
+    {
+      memmove(child->children + 1, child->children, (child->count + 1) * sizeof(bpt_node_t *));
+      child->keys[0] = parent->keys[i - 1];
+      child->children[0] = left->children[left->count];
+      parent->keys[i - 1] = left->keys[left->count - 1];
+    }
+    child->count++;
+    left->count--;
+    return;
+  }
+
+  if (right && right->count > BPT_MIN)                                // we borrow the smallest key of the right sibling
+  {
+    if (child->leaf)
+    {
+      child->keys[child->count] = right->keys[0];
+      child->values[child->count] = right->values[0];
+      memmove(right->values, right->values + 1, (right->count - 1) * sizeof(int));
+      parent->keys[i] = right->keys[1];                               // leaf separator is the next first key
+    }
+    else
+    {
+      child->keys[child->count] = parent->keys[i];
+      child->children[child->count + 1] = right->children[0];
+      memmove(right->children, right->children + 1, right->count * sizeof(bpt_node_t *));
+      parent->keys[i] = right->keys[0];                               // first key of the inner node moves up
+    }
+    memmove(right->keys, right->keys + 1, right->count - 1);
+    child->count++;
+    right->count--;
+    return;
+  }
+
+  if (!right)                                                         // the last child merges into its left sibling
+  {
+    right = child;
+    child = left;
+    i--;
+  }
+
+  if (child->leaf)                                                    // we merge right sibling into the child
+  {
+    memcpy(child->keys + child->count, right->keys, right->count);
+    memcpy(child->values + child->count, right->values, right->count * sizeof(int));
+    child->next = right->next;
+  }
+  else
+  {
+    child->keys[child->count++] = parent->keys[i];
+    memcpy(child->keys + child->count, right->keys, right->count);
+    memcpy(child->children + child->count, right->children, (right->count + 1) * sizeof(bpt_node_t *));
+  }
+  child->count += right->count;
+  free(right);
+
+  memmove(parent->keys + i, parent->keys + i + 1, parent->count - i - 1);  // separator and right sibling leave the parent
+  memmove(parent->children + i + 1, parent->children + i + 2, (parent->count - i - 1) * sizeof(bpt_node_t *));
+  parent->count--;
+}
+
+/*
+ * Inicializace stromu.
+ */
+void bpt_init(bpt_node_t **tree) {
+  *tree = NULL;
+}
+
+/*
+ * Vyhledání klíče ve stromu.
+ *
+ * Návratová hodnota a value jako u bst_search.
+ */
+bool bpt_search(bpt_node_t *tree, char key, int *value) {
+  if (!tree) return false;
+
+  while (!tree->leaf)
+  {
+    tree = tree->children[countBelow(tree, key, true)];             // child holding keys up to the next separator
+  }
+
+  int i = countBelow(tree, key, false);
+  if (i < tree->count && tree->keys[i] == key)
+  {
+    *value = tree->values[i];
+    return true;
+  }
+  return false;
+}
+
+/*
+ * Vložení dvojice klíč-hodnota do stromu.
+ *
+ * Pokud klíč už ve stromu existuje, nahradí se jeho hodnota.
+ */
+void bpt_insert(bpt_node_t **tree, char key, int value) {
+  if (!*tree)
+  {
+    *tree = newNode(true);                                            // first leaf becomes the root
+    if (!*tree) return;
+  }
+
+  if ((*tree)->count == BPT_ORDER)                                    // full root is split, tree grows by one level
+  {
+    bpt_node_t *root = newNode(false);
+    if (!root) return;
+    root->children[0] = *tree;
+    if (!splitChild(root, 0))
+    {
+      free(root);
+      return;
+    }
+    *tree = root;
+  }
+
+  bpt_node_t *node = *tree;
+  while (!node->leaf)
+  {
+    int i = countBelow(node, key, true);
+    if (node->children[i]->count == BPT_ORDER)                        // we split a full child before going down
+    {
+      if (!splitChild(node, i)) return;
+      if (key >= node->keys[i]) i++;
+    }
+    node = node->children[i];
+  }
+
+  int i = countBelow(node, key, false);
+  if (i < node->count && node->keys[i] == key)
+  {
+    node->values[i] = value;                                          // key exists, we replace the value
+    return;
+  }
+
+  memmove(node->keys + i + 1, node->keys + i, node->count - i);
+  memmove(node->values + i + 1, node->values + i, (node->count - i) * sizeof(int));
+  node->keys[i] = key;
+  node->values[i] = value;
+  node->count++;
+}
+
+/*
+ * Odstranění klíče ze stromu.
+ *
+ * Pokud klíč ve stromu neexistuje, struktura stromu zůstává platná a obsah
+ * stromu se nemění.
+ */
+void bpt_delete(bpt_node_t **tree, char key) {
+  bpt_node_t *node = *tree;
+  if (!node) return;
+
+  while (!node->leaf)
+  {
+    int i = countBelow(node, key, true);
+    if (node->children[i]->count <= BPT_MIN)                          // we fill a minimal child before going down
+    {
+      fillChild(node, i);
+      if (node == *tree && node->count == 0)                          // root lost its last key, tree shrinks
+      {
+        *tree = node->children[0];
+        free(node);
+        node = *tree;
+        continue;
+      }
+      i = countBelow(node, key, true);
+    }
+    node = node->children[i];
+  }
+
+  int i = countBelow(node, key, false);
+  if (i < node->count && node->keys[i] == key)
+  {
+    memmove(node->keys + i, node->keys + i + 1, node->count - i - 1);
+    memmove(node->values + i, node->values + i + 1, (node->count - i - 1) * sizeof(int));
+    node->count--;
+  }
+
+  if (node == *tree && node->count == 0)                              // empty root leaf means empty tree
+  {
+    free(node);
+    *tree = NULL;
+  }
+}
+
+/*
+ * Zrušení celého stromu.
+ */
+void bpt_dispose(bpt_node_t **tree) {
+  if (*tree)
+  {
+    if (!(*tree)->leaf)
+    {
+      for (int i = 0; i <= (*tree)->count; i++)
+      {
+        bpt_dispose(&(*tree)->children[i]);                           // we dispose all children first
+      }
+    }
+    free(*tree);
+    *tree = NULL;
+  }
+}
+
+/*
+ * Průchod rozsahem klíčů <lo, hi>.
+ *
+ * Funkce najde list s klíčem lo a dále postupuje pouze po zřetězených
+ * listech. Pro každou dvojici v rozsahu zavolá visit ve vzestupném pořadí.
+ */
+void bpt_range(bpt_node_t *tree, char lo, char hi, bpt_visitor_t visit, void *data) {
+  if (!tree) return;
+
+  while (!tree->leaf)
+  {
+    tree = tree->children[countBelow(tree, lo, true)];
+  }
+
+  for (int i = countBelow(tree, lo, false); tree; tree = tree->next, i = 0)
+  {
+    for (; i < tree->count; i++)
+    {
+      if (tree->keys[i] > hi) return;                                 // we passed the end of the range
+      visit(tree->keys[i], tree->values[i], data);
+    }
+  }
+}
+
+/*
+ * Sestavení stromu z pole dvojic seřazených podle klíče.
+ *
+ * Klíče musí být ostře rostoucí. Listy se plní rovnoměrně a vnitřní uzly se
+ * sestavují po úrovních zdola nahoru, bez vyhledávání a dělení uzlů.
+ * Případný předchozí obsah stromu je nutné nejdříve zrušit.
+ */
+void bpt_bulk_load(bpt_node_t **tree, const char keys[], const int values[], int count) {
+  *tree = NULL;
+  if (count <= 0) return;
+
+  int nodes = (count + BPT_ORDER - 1) / BPT_ORDER;                    // number of leaves
+  bpt_node_t **level = malloc(nodes * sizeof(bpt_node_t *));
+  char *mins = malloc(nodes);                                         // smallest key of every subtree
+  if (!level || !mins)
+  {
+    free(level);
+    free(mins);
+    return;
+  }
+
+  bpt_node_t *prev = NULL;
+  for (int n = 0, done = 0; n < nodes; n++)                           // leaves get count/nodes keys or one more
+  {
+    int take = count / nodes + (n < count % nodes);
+    bpt_node_t *leaf = newNode(true);
+    if (!leaf)                                                        // we give up and free the built leaves
+    {
+      for (int i = 0; i < n; i++) free(level[i]);
+      free(level);
+      free(mins);
+      return;
+    }
+    memcpy(leaf->keys, keys + done, take);
+    memcpy(leaf->values, values + done, take * sizeof(int));
+    leaf->count = take;
+    if (prev) prev->next = leaf;
+    prev = leaf;
+    level[n] = leaf;
+    mins[n] = leaf->keys[0];
+    done += take;
+  }
+
+  while (nodes > 1)                                                   // we build inner levels until one root remains
+  {
+    int parents = (nodes + BPT_ORDER) / (BPT_ORDER + 1);
+    int done = 0;
+    for (int p = 0; p < parents; p++)
+    {
+      int take = nodes / parents + (p < nodes % parents);
+      bpt_node_t *node = newNode(false);
+      if (!node)                                                      // we give up and free the unlinked nodes
+      {
+        for (int i = done; i < nodes; i++) bpt_dispose(&level[i]);
+        for (int i = 0; i < p; i++) bpt_dispose(&level[i]);
+        free(level);
+        free(mins);
+        return;
+      }
+      for (int c = 0; c < take; c++)
+      {
+        node->children[c] = level[done + c];
+        if (c > 0) node->keys[c - 1] = mins[done + c];
+      }
+      node->count = take - 1;
+      level[p] = node;
+      mins[p] = mins[done];
+      done += take;
+    }
+    nodes = parents;
+  }
+
+  *tree = level[0];
+  free(level);
+  free(mins);
+}
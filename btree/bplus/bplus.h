@@ -0,0 +1,39 @@
+/*
+ * Hlavičkový soubor pro B+ strom s vysokým stupněm větvení.
+ */
+
+#ifndef IAL_BTREE_BPLUS_H
+#define IAL_BTREE_BPLUS_H
+
+#include <stdbool.h>
+
+// Maximální počet klíčů v uzlu, musí být násobkem 16 (šířka SIMD porovnání)
+#ifndef BPT_ORDER
+#define BPT_ORDER 32
+#endif
+
+// Uzel stromu
+typedef struct bpt_node {
+  char keys[BPT_ORDER];                     // seřazené klíče
+  bool leaf;                                // příznak listu
+  int count;                                // počet klíčů
+  struct bpt_node *next;                    // následující list (pouze listy)
+  union {
+    struct bpt_node *children[BPT_ORDER + 1]; // potomci vnitřního uzlu
+    int values[BPT_ORDER];                  // hodnoty listu
+  };
+} bpt_node_t;
+
+// Funkce volaná pro každou dvojici klíč-hodnota průchodu rozsahem
+typedef void (*bpt_visitor_t)(char key, int value, void *data);
+
+void bpt_init(bpt_node_t **tree);
+void bpt_insert(bpt_node_t **tree, char key, int value);
+bool bpt_search(bpt_node_t *tree, char key, int *value);
+void bpt_delete(bpt_node_t **tree, char key);
+void bpt_dispose(bpt_node_t **tree);
+
+void bpt_range(bpt_node_t *tree, char lo, char hi, bpt_visitor_t visit, void *data);
+void bpt_bulk_load(bpt_node_t **tree, const char keys[], const int values[], int count);
+
+#endif
@@ -0,0 +1,93 @@
+#include "bplus.h"
+#include "../test_check.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+void print_visitor(char key, int value, void *data) {
+  printf("[%c,%d]", key, value);
+  (*(int *)data)++;
+}
+
+// Inserts all 256 keys in an order that splits leaves and inner nodes
+void insert_all(bpt_node_t **tree) {
+  for (int i = 0; i < 256; i++) {
+    char key = (char)((i * 37) % 256 - 128);
+    bpt_insert(tree, key, key * 2);
+  }
+}
+
+bool search_all(bpt_node_t *tree, bool (*present)(int key)) {
+  for (int key = -128; key < 128; key++) {
+    int value;
+    bool found = bpt_search(tree, (char)key, &value);
+    if (found != present(key) || (found && value != key * 2)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool all_keys(int key) { return true; }
+bool odd_keys(int key) { return key % 2 != 0; }
+
+int main(int argc, char *argv[]) {
+  printf("B+ Tree - testing script\n");
+  printf("------------------------\n\n");
+
+  bpt_node_t *tree;
+  bpt_init(&tree);
+
+  printf("[test_bpt_insert_many] Insert many values\n");
+  for (int i = 0; i < base_data_count; i++) {
+    bpt_insert(&tree, base_keys[i], base_values[i]);
+  }
+  int result;
+  check(bpt_search(tree, 'A', &result) && result == 1 &&
+            !bpt_search(tree, 'X', &result),
+        "Node A was found and node X was not");
+
+  printf("[test_bpt_update] Update a value (H,8)->(H,80)\n");
+  bpt_insert(&tree, 'H', 80);
+  check(bpt_search(tree, 'H', &result) && result == 80,
+        "Value of the H node was updated");
+
+  printf("[test_bpt_range] Scan the range <C, J>\n");
+  int visited = 0;
+  bpt_range(tree, 'C', 'J', print_visitor, &visited);
+  printf("\n");
+  check(visited == 8, "Range <C, J> contains 8 items");
+  bpt_dispose(&tree);
+
+  printf("[test_bpt_split] Insert all 256 keys\n");
+  insert_all(&tree);
+  check(!tree->leaf && search_all(tree, all_keys), "All keys were found");
+
+  printf("[test_bpt_merge] Delete all even keys\n");
+  for (int key = -128; key < 128; key += 2) {
+    bpt_delete(&tree, (char)key);
+  }
+  check(search_all(tree, odd_keys), "Only odd keys were found");
+
+  printf("[test_bpt_delete_all] Delete all keys\n");
+  for (int key = -128; key < 128; key++) {
+    bpt_delete(&tree, (char)key);
+  }
+  check(tree == NULL, "Tree is empty");
+
+  printf("[test_bpt_bulk_load] Bulk load all 256 keys\n");
+  char keys[256];
+  int values[256];
+  for (int i = 0; i < 256; i++) {
+    keys[i] = (char)(i - 128);
+    values[i] = keys[i] * 2;
+  }
+  bpt_bulk_load(&tree, keys, values, 256);
+  visited = 0;
+  bpt_range(tree, 'a', 'z', print_visitor, &visited);
+  printf("\n");
+  check(search_all(tree, all_keys) && visited == 26,
+        "All keys were found and range <a, z> contains 26 items");
+  bpt_dispose(&tree);
+
+  return tests_summary();
+}
@@ -1,4 +1,5 @@
 #include "btree.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -20,4 +21,575 @@ void bst_add_node_to_items(bst_node_t* node, bst_items_t *items) {
   }
   items->nodes[items->size] = node;
   items->size++;
-}
\ No newline at end of file
+}
+
+/*
+ * Počet uzlů stromu.
+ *
+ * Hodnota se čte z uzlu, strom se neprochází.
+ */
+int bst_size(bst_node_t *tree) {
+  return tree ? tree->size : 0;
+}
+
+/*
+ * Pravá rotace uzlu.
+ *
+ * Na místo uzlu pod odkazem link se dostane jeho levý potomek, který musí
+ * existovat. Velikosti podstromů se upraví jen u dvou otočených uzlů.
+ */
+void bst_rotate_right(bst_node_t **link) {
+  bst_node_t *node = *link;
+  bst_node_t *child = node->left;
+
+  node->left = child->right;                      // inner subtree of the child changes its parent
+  child->right = node;
+  *link = child;
+
+  node->size = 1 + bst_size(node->left) + bst_size(node->right);
+  child->size = 1 + bst_size(child->left) + node->size;
+}
+
+/*
+ * Levá rotace uzlu.
+ *
+ * Na místo uzlu pod odkazem link se dostane jeho pravý potomek, který musí
+ * existovat. Velikosti podstromů se upraví jen u dvou otočených uzlů.
+ */
+void bst_rotate_left(bst_node_t **link) {
+  bst_node_t *node = *link;
+  bst_node_t *child = node->right;
+
+  node->right = child->left;                      // inner subtree of the child changes its parent
+  child->left = node;
+  *link = child;
+
+  node->size = 1 + bst_size(node->left) + bst_size(node->right);
+  child->size = 1 + node->size + bst_size(child->right);
+}
+
+/*
+ * Pořadí klíče.
+ *
+ * Vrací počet klíčů stromu, které jsou menší než key. Klíč key ve stromu být
+ * nemusí. Funkce prochází jedinou cestou od kořene.
+ */
+int bst_rank(bst_node_t *tree, char key) {
+  int rank = 0;
+
+  while(tree)
+  {
+    if(key <= tree->key)
+    {
+      tree = tree->left;                          // all smaller keys are in the left subtree
+    }
+    else
+    {
+      rank += bst_size(tree->left) + 1;           // left subtree and the node itself are smaller
+      tree = tree->right;
+    }
+  }
+  return rank;
+}
+
+/*
+ * Výběr k-tého nejmenšího uzlu.
+ *
+ * Pořadí k se počítá od nuly, bst_select(tree, bst_size(tree) / 2) tedy
+ * vrací medián. Pokud k neleží v intervalu <0, bst_size(tree) - 1>, funkce
+ * vrací NULL.
+ */
+bst_node_t *bst_select(bst_node_t *tree, int k) {
+  while(tree)
+  {
+    int left = bst_size(tree->left);
+
+    if(k < left)
+    {
+      tree = tree->left;                          // k-th node is in the left subtree
+    }
+    else if(k == left)
+    {
+      return tree;                                // exactly k nodes are smaller
+    }
+    else
+    {
+      k -= left + 1;                              // we skip the left subtree and the node
+      tree = tree->right;
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Počet klíčů v rozsahu <lo, hi>.
+ */
+int bst_count_range(bst_node_t *tree, char lo, char hi) {
+  if(lo > hi) return 0;
+
+  int at_most_hi = 0;                             // number of keys less or equal to hi
+  for(bst_node_t *node = tree; node; )
+  {
+    if(hi < node->key)
+    {
+      node = node->left;
+    }
+    else
+    {
+      at_most_hi += bst_size(node->left) + 1;
+      node = node->right;
+    }
+  }
+
+  return at_most_hi - bst_rank(tree, lo);
+}
+
+// Function to tell if node a comes before node b in the top-K order, greater value first and equal values by key
+bool ranksBefore(bst_node_t *a, bst_node_t *b)
+{
+  return a->value != b->value ? a->value > b->value : a->key < b->key;
+}
+
+// Function to move the node at index down the heap, the root is the node which ranks last
+void siftDownTopK(bst_node_t **heap, int count, int index)
+{
+  while(true)
+  {
+    int last = index;
+    int left = 2 * index + 1;
+    int right = left + 1;
+
+    if(left < count && ranksBefore(heap[last], heap[left])) last = left;
+    if(right < count && ranksBefore(heap[last], heap[right])) last = right;
+    if(last == index) return;
+
+    bst_node_t *tmp = heap[index];
+    heap[index] = heap[last];
+    heap[last] = tmp;
+    index = last;
+  }
+}
+
+// Function to offer every node of the subtree to the heap of at most k nodes
+void collectTopK(bst_node_t *node, bst_node_t **heap, int *count, int k)
+{
+  if(!node) return;
+
+  collectTopK(node->left, heap, count, k);
+
+  if(*count < k)                                  // heap is not full yet, we sift the node up
+  {
+    int i = (*count)++;
+    heap[i] = node;
+    for(; i > 0 && ranksBefore(heap[(i - 1) / 2], heap[i]); i = (i - 1) / 2)
+    {
+      bst_node_t *tmp = heap[i];
+      heap[i] = heap[(i - 1) / 2];
+      heap[(i - 1) / 2] = tmp;
+    }
+  }
+  else if(ranksBefore(node, heap[0]))             // node beats the last of the top k, it replaces it
+  {
+    heap[0] = node;
+    siftDownTopK(heap, k, 0);
+  }
+
+  collectTopK(node->right, heap, count, k);
+}
+
+/*
+ * Uzly s největšími hodnotami.
+ *
+ * Přidá na konec pole items nejvýše k uzlů s největšími hodnotami seřazených
+ * sestupně podle hodnoty, uzly se stejnou hodnotou vzestupně podle klíče.
+ * Strom se projde jednou a po celou dobu se udržuje jen halda k nejlepších
+ * uzlů, místo seřazení všech uzlů stačí čas O(n log k). Při nedostatku
+ * paměti zůstane pole beze změny.
+ */
+void bst_top_k(bst_node_t *tree, int k, bst_items_t *items) {
+  if(k > bst_size(tree)) k = bst_size(tree);
+  if(k <= 0) return;
+
+  if(items->capacity < items->size + k)
+  {
+    bst_node_t **nodes = realloc(items->nodes, sizeof(bst_node_t *) * (items->size + k));
+    if(!nodes) return;
+
+    items->nodes = nodes;
+    items->capacity = items->size + k;
+  }
+
+  bst_node_t **heap = items->nodes + items->size; // heap is built right where the result goes
+  int count = 0;
+  collectTopK(tree, heap, &count, k);
+
+  for(int end = count - 1; end > 0; end--)        // the last ranking node moves to the end, best nodes stay in front
+  {
+    bst_node_t *tmp = heap[0];
+    heap[0] = heap[end];
+    heap[end] = tmp;
+    siftDownTopK(heap, end, 0);
+  }
+
+  items->size += count;
+}
+
+// Function to build a balanced subtree from the sorted pairs start..end, failed is set when allocation fails
+bst_node_t *buildTreeFromSortedPairs(const char keys[], const int values[], int start, int end, bool *failed)
+{
+  if(start > end) return NULL;                    // if start is greater than end, there is no subtree
+
+  int mid = (start + end) / 2;                    // we get the middle element
+  bst_node_t *root = bst_node_alloc();            // root is allocated before its subtrees, so nodes lie in preorder
+  if(!root)
+  {
+    *failed = true;
+    return NULL;
+  }
+
+  root->key = keys[mid];
+  root->value = values[mid];
+  root->size = end - start + 1;
+  root->left = buildTreeFromSortedPairs(keys, values, start, mid - 1, failed);
+  root->right = buildTreeFromSortedPairs(keys, values, mid + 1, end, failed);
+
+  return root;
+}
+
+/*
+ * Sestavení vyváženého stromu z pole dvojic seřazených podle klíče.
+ *
+ * Klíče musí být ostře rostoucí. Strom se sestaví jedním lineárním
+ * průchodem bez vyhledávání, prostřední prvek každého úseku se stane
+ * kořenem podstromu. Je-li aktivní alokátor bst_pool, uzly leží v jeho
+ * souvislých blocích v pořadí preorder.
+ *
+ * Případný předchozí obsah stromu je nutné nejdříve zrušit. Při nedostatku
+ * paměti zůstane strom prázdný.
+ */
+void bst_build_from_sorted(bst_node_t **tree, const char keys[], const int values[], int count) {
+  bool failed = false;
+
+  *tree = buildTreeFromSortedPairs(keys, values, 0, count - 1, &failed);
+
+  if(failed)
+  {
+    bst_dispose(tree);                            // we do not leave a tree with missing keys
+  }
+}
+
+/*
+ * Sestavení vyváženého stromu z neseřazeného pole dvojic.
+ *
+ * Výsledek odpovídá postupnému vložení dvojic funkcí bst_insert, při
+ * opakovaném klíči tedy platí poslední hodnota, strom je však vyvážený.
+ * Klíče typu char se řadí přihrádkovým řazením do 256 přihrádek v čase
+ * O(n), poté se strom sestaví funkcí bst_build_from_sorted.
+ */
+void bst_build_from_array(bst_node_t **tree, const char keys[], const int values[], int count) {
+  bool present[UCHAR_MAX + 1] = {false};
+  int bucket_values[UCHAR_MAX + 1];
+
+  for(int i = 0; i < count; i++)
+  {
+    int bucket = keys[i] - CHAR_MIN;              // buckets are ordered the same way as char keys
+    present[bucket] = true;
+    bucket_values[bucket] = values[i];            // later value replaces the earlier one
+  }
+
+  char sorted_keys[UCHAR_MAX + 1];
+  int sorted_values[UCHAR_MAX + 1];
+  int size = 0;
+
+  for(int bucket = 0; bucket <= UCHAR_MAX; bucket++)
+  {
+    if(present[bucket])
+    {
+      sorted_keys[size] = (char)(bucket + CHAR_MIN);
+      sorted_values[size] = bucket_values[bucket];
+      size++;
+    }
+  }
+
+  bst_build_from_sorted(tree, sorted_keys, sorted_values, size);
+}
+
+// Function to build a balanced subtree from the sorted array of nodes start..end, nodes are relinked, not copied
+bst_node_t *buildTreeFromSortedArray(bst_items_t *items, int start, int end)
+{
+  if(start > end) return NULL;                    // if start is greater than end, there is no subtree
+
+  int mid = (start + end) / 2;                    // we get the middle element
+  bst_node_t *root = items->nodes[mid];           // we set the middle element as root
+
+  root->left = buildTreeFromSortedArray(items, start, mid - 1);
+  root->right = buildTreeFromSortedArray(items, mid + 1, end);
+  root->size = end - start + 1;                   // subtree holds all nodes from start to end
+
+  return root;
+}
+
+/*
+ * Přestavění stromu na dokonale vyvážený.
+ *
+ * Uzly se průchodem inorder uloží do pole a z něj se znovu propojí tak, že
+ * prostřední uzel každého úseku se stane kořenem podstromu. Uzly se
+ * nealokují ani nekopírují. Funkci lze volat i na podstrom, velikosti
+ * předků se nemění. Při nedostatku paměti zůstane strom beze změny.
+ */
+void bst_rebuild(bst_node_t **tree) {
+  bst_items_t items;
+  items.capacity = bst_size(*tree);
+  items.nodes = malloc(sizeof(bst_node_t *) * (items.capacity + 1));
+  items.size = 0;
+
+  if(!items.nodes) return;                        // allocation check
+
+  bst_inorder(*tree, &items);                     // getting sorted nodes by inorder traversal
+
+  *tree = buildTreeFromSortedArray(&items, 0, items.size - 1);
+
+  free(items.nodes);
+}
+
+/*
+ * Parametr automatického vyvažování.
+ *
+ * Hodnota 0 automatické vyvažování vypíná. Hodnota v intervalu (0.5, 1)
+ * zapíná vyvažování obětním beránkem (scapegoat), kdy bst_insert po vložení
+ * uzlu do hloubky větší než log_{1/α}(n) přestaví nejmenší podstrom na
+ * cestě, ve kterém má potomek více než α-násobek uzlů svého rodiče. Menší
+ * hodnota znamená nižší strom za cenu častějšího přestavování.
+ */
+double bst_alpha = 0;
+
+/*
+ * Vyvážení cesty k nově vloženému uzlu.
+ *
+ * Volá se z bst_insert po vložení nového uzlu s klíčem key do hloubky depth
+ * (kořen má hloubku 0) a po aktualizaci velikostí podstromů. Pokud je
+ * automatické vyvažování vypnuté nebo hloubka nepřekračuje mez, funkce
+ * nic nedělá. Amortizovaná cena vložení je O(log n).
+ */
+void bst_scapegoat(bst_node_t **tree, char key, int depth) {
+  if(bst_alpha <= 0) return;                      // automatic balancing is off
+
+  double limit = 1;                               // (1/alpha)^depth, compared with the size
+  for(int i = 0; i < depth && limit <= (*tree)->size; i++)
+  {
+    limit /= bst_alpha;
+  }
+
+  if(limit <= (*tree)->size) return;              // depth <= log_{1/alpha}(n), tree is still alpha-height-balanced
+
+  bst_node_t **path[UCHAR_MAX + 2];               // char keys limit the depth, root link is path[0]
+  path[0] = tree;
+  for(int i = 0; i < depth; i++)
+  {
+    bst_node_t *current = *path[i];
+    path[i + 1] = key < current->key ? &current->left : &current->right;
+  }
+
+  for(int i = depth - 1; i >= 0; i--)             // we look for the lowest unbalanced ancestor
+  {
+    if(bst_size(*path[i + 1]) > bst_alpha * (*path[i])->size)
+    {
+      bst_rebuild(path[i]);                       // ancestors keep their sizes, so one rebuild is enough
+      return;
+    }
+  }
+}
+
+// Function to split the subtree into keys less than key and the others, sizes are updated on the way back
+void splitNode(bst_node_t *node, char key, bst_node_t **lt, bst_node_t **ge)
+{
+  if(!node)
+  {
+    *lt = NULL;
+    *ge = NULL;
+    return;
+  }
+
+  if(node->key < key)                             // node and its left subtree stay less, its right subtree is split
+  {
+    splitNode(node->right, key, &node->right, ge);
+    *lt = node;
+  }
+  else                                            // node and its right subtree stay greater, its left subtree is split
+  {
+    splitNode(node->left, key, lt, &node->left);
+    *ge = node;
+  }
+
+  node->size = 1 + bst_size(node->left) + bst_size(node->right);
+}
+
+/*
+ * Rozdělení stromu podle klíče.
+ *
+ * Uzly s klíčem menším než key přesune do stromu lt, ostatní do stromu ge,
+ * strom tree zůstane prázdný. Uzly se nekopírují, mění se pouze ukazatele na
+ * jediné cestě od kořene, složitost je tedy O(h). Oba výsledné stromy mají
+ * nejvýše výšku původního stromu.
+ */
+void bst_split(bst_node_t **tree, char key, bst_node_t **lt, bst_node_t **ge) {
+  bst_node_t *root = *tree;
+
+  *tree = NULL;
+  splitNode(root, key, lt, ge);
+}
+
+// Function to detach the leftmost node of the subtree, sizes on the path are decreased
+bst_node_t *detachLeftmost(bst_node_t **tree)
+{
+  while((*tree)->left)
+  {
+    (*tree)->size--;
+    tree = &(*tree)->left;
+  }
+
+  bst_node_t *leftmost = *tree;
+  *tree = leftmost->right;
+  return leftmost;
+}
+
+// Function to get the height of a balanced subtree of the size, it is the bit length of size
+int balancedHeight(int size)
+{
+  return size ? 32 - __builtin_clz((unsigned)size) : 0;
+}
+
+// Function to detach the rightmost node of the subtree, sizes on the path are decreased
+bst_node_t *detachRightmost(bst_node_t **tree)
+{
+  while((*tree)->right)
+  {
+    (*tree)->size--;
+    tree = &(*tree)->right;
+  }
+
+  bst_node_t *rightmost = *tree;
+  *tree = rightmost->left;
+  return rightmost;
+}
+
+// Function to concatenate two subtrees, all keys of lower are less than all keys of upper
+bst_node_t *concatTrees(bst_node_t *lower, bst_node_t *upper)
+{
+  if(!lower) return upper;
+  if(!upper) return lower;
+
+  bst_node_t *root, *node;
+  bst_node_t **link;
+
+  if(lower->size >= upper->size)                  // least node of the smaller upper joins it onto the right spine of lower
+  {
+    int height = balancedHeight(upper->size);     // upper is not taller after the node is detached
+    node = detachLeftmost(&upper);
+    root = lower;
+    link = &root;
+    while(balancedHeight(bst_size(*link)) > height)   // we go down until the subtree is not taller than upper
+    {
+      (*link)->size += 1 + bst_size(upper);
+      link = &(*link)->right;
+    }
+    node->left = *link;
+    node->right = upper;
+  }
+  else                                            // greatest node of the smaller lower joins it onto the left spine of upper
+  {
+    int height = balancedHeight(lower->size);
+    node = detachRightmost(&lower);
+    root = upper;
+    link = &root;
+    while(balancedHeight(bst_size(*link)) > height)
+    {
+      (*link)->size += 1 + bst_size(lower);
+      link = &(*link)->left;
+    }
+    node->left = lower;
+    node->right = *link;
+  }
+
+  node->size = 1 + bst_size(node->left) + bst_size(node->right);
+  *link = node;                                   // node takes the place of the subtree it now holds
+  return root;
+}
+
+// Function to merge two subtrees with overlapping keys, values of other win
+bst_node_t *unionTrees(bst_node_t *tree, bst_node_t *other)
+{
+  if(!tree) return other;
+  if(!other) return tree;
+
+  bst_node_t *lt, *ge;
+  splitNode(other, tree->key, &lt, &ge);          // other is split around the root of tree
+
+  if(ge)
+  {
+    bst_node_t *leftmost = ge;
+    while(leftmost->left)
+    {
+      leftmost = leftmost->left;
+    }
+
+    if(leftmost->key == tree->key)                // the same key is in both trees
+    {
+      tree->value = leftmost->value;
+      bst_node_free(detachLeftmost(&ge));
+    }
+  }
+
+  tree->left = unionTrees(tree->left, lt);
+  tree->right = unionTrees(tree->right, ge);
+  tree->size = 1 + bst_size(tree->left) + bst_size(tree->right);
+
+  return tree;
+}
+
+/*
+ * Spojení dvou stromů.
+ *
+ * Uzly stromu other přesune do stromu tree, strom other zůstane prázdný.
+ * Jsou-li všechny klíče stromu tree menší než všechny klíče stromu other
+ * (nebo naopak), stromy se spojí podél jediné cesty v čase O(h1 + h2).
+ * Krajní uzel menšího stromu se pak stane kořenem podstromu na páteři
+ * většího stromu, který není vyšší, než by byl vyvážený menší strom. Pro
+ * vyvážené stromy, například po bst_balance, je výsledek nejvýše o jedna
+ * vyšší než vyšší z nich. Výšku nevyvážených stromů spojení nesnižuje.
+ * Jinak se strom other postupně rozdělí podle kořenů podstromů stromu tree
+ * a jeho části se připojí na odpovídající místa. Pro klíč obsažený v obou
+ * stromech platí hodnota ze stromu other a jeho nadbytečný uzel se uvolní.
+ */
+void bst_join(bst_node_t **tree, bst_node_t **other) {
+  bst_node_t *first = *tree;
+  bst_node_t *second = *other;
+
+  *other = NULL;
+
+  if(!first || !second)
+  {
+    *tree = first ? first : second;
+    return;
+  }
+
+  bst_node_t *first_min = first, *first_max = first;
+  bst_node_t *second_min = second, *second_max = second;
+  while(first_min->left) first_min = first_min->left;
+  while(first_max->right) first_max = first_max->right;
+  while(second_min->left) second_min = second_min->left;
+  while(second_max->right) second_max = second_max->right;
+
+  if(first_max->key < second_min->key)            // key ranges do not overlap, a single path is enough
+  {
+    *tree = concatTrees(first, second);
+  }
+  else if(second_max->key < first_min->key)
+  {
+    *tree = concatTrees(second, first);
+  }
+  else
+  {
+    *tree = unionTrees(first, second);
+  }
+}
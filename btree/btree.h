@@ -7,16 +7,44 @@
 #define IAL_BTREE_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
 // Uzel stromu
 typedef struct bst_node {
   char key;               // klíč
   int value;              // hodnota
+  int size;               // počet uzlů podstromu včetně tohoto uzlu
   struct bst_node *left;  // levý potomek
   struct bst_node *right; // pravý potomek
 } bst_node_t;
 
+// Blok uzlů alokátoru
+typedef struct bst_chunk {
+  struct bst_chunk *next; // další blok
+  int capacity;           // počet uzlů v bloku
+  int used;               // počet již vydaných uzlů
+  bst_node_t nodes[];     // souvislé pole uzlů
+} bst_chunk_t;
+
+// Alokátor uzlů jednoho stromu
+typedef struct bst_pool {
+  bst_chunk_t *chunks;    // seznam alokovaných bloků
+  bst_node_t *free_nodes; // uvolněné uzly zřetězené přes ukazatel left
+} bst_pool_t;
+
+// Aktivní alokátor vlákna, NULL znamená alokaci pomocí malloc/free
+extern _Thread_local bst_pool_t *bst_pool;
+
+void bst_pool_init(bst_pool_t *pool);
+void bst_pool_dispose(bst_pool_t *pool, bst_node_t **tree);
+bst_node_t *bst_node_alloc();
+void bst_node_free(bst_node_t *node);
+
 void bst_init(bst_node_t **tree);
+void bst_build_from_sorted(bst_node_t **tree, const char keys[], const int values[], int count);
+void bst_build_from_array(bst_node_t **tree, const char keys[], const int values[], int count);
 void bst_insert(bst_node_t **tree, char key, int value);
 bool bst_search(bst_node_t *tree, char key, int *value);
 void bst_delete(bst_node_t **tree, char key);
@@ -35,11 +63,80 @@ void bst_preorder(bst_node_t *tree, bst_items_t *items);
 void bst_inorder(bst_node_t *tree, bst_items_t *items);
 void bst_postorder(bst_node_t *tree, bst_items_t *items);
 
+// Funkce volaná pro každý navštívený uzel
+typedef void (*bst_visitor_t)(bst_node_t *node, void *data);
+
+void bst_range(bst_node_t *tree, char lo, char hi, bst_visitor_t visit, void *data);
+
 void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree);
 
+int bst_size(bst_node_t *tree);
+void bst_rotate_right(bst_node_t **link);
+void bst_rotate_left(bst_node_t **link);
+int bst_rank(bst_node_t *tree, char key);
+bst_node_t *bst_select(bst_node_t *tree, int k);
+int bst_count_range(bst_node_t *tree, char lo, char hi);
+void bst_top_k(bst_node_t *tree, int k, bst_items_t *items);
+
+void bst_split(bst_node_t **tree, char key, bst_node_t **lt, bst_node_t **ge);
+void bst_join(bst_node_t **tree, bst_node_t **other);
+
 void bst_print_node(bst_node_t *node);
 
+bool bst_splay_search(bst_node_t **tree, char key, int *value);
+void bst_splay_insert(bst_node_t **tree, char key, int value);
+void bst_splay_delete(bst_node_t **tree, char key);
+
+// Statické vyhledávací pole v Eytzingerově pořadí
+typedef struct bst_flat {
+  char *keys;             // klíče, kořen na indexu 1, potomci uzlu i na 2i a 2i+1
+  int *values;            // hodnoty na stejných indexech jako klíče
+  int size;               // počet uložených uzlů
+  void *map;              // namapovaný soubor, NULL u pole sestaveného v paměti
+  size_t map_size;        // délka namapovaného souboru
+} bst_flat_t;
+
+void bst_compile(bst_node_t *tree, bst_flat_t *flat);
+bool bst_flat_search(bst_flat_t *flat, char key, int *value);
+void bst_flat_dispose(bst_flat_t *flat);
+
+// Uspořádaná mapa klíčů typu char přímo indexovaná klíčem
+typedef struct bst_dense {
+  int values[256];        // hodnota klíče key na indexu key - CHAR_MIN
+  uint64_t present[4];    // bitová mapa přítomných klíčů, index i je bit i % 64 slova i / 64
+} bst_dense_t;
+
+// Funkce volaná pro každý navštívený klíč mapy
+typedef void (*bst_dense_visitor_t)(char key, int value, void *data);
+
+void bst_dense_init(bst_dense_t *dense);
+void bst_dense_insert(bst_dense_t *dense, char key, int value);
+bool bst_dense_search(bst_dense_t *dense, char key, int *value);
+void bst_dense_delete(bst_dense_t *dense, char key);
+int bst_dense_size(bst_dense_t *dense);
+int bst_dense_rank(bst_dense_t *dense, char key);
+bool bst_dense_select(bst_dense_t *dense, int k, char *key);
+bool bst_dense_next(bst_dense_t *dense, char key, char *next);
+void bst_dense_range(bst_dense_t *dense, char lo, char hi, bst_dense_visitor_t visit, void *data);
+void bst_dense_from_tree(bst_dense_t *dense, bst_node_t *tree);
+
+bool bst_save(bst_node_t *tree, FILE *file);
+bool bst_load(bst_node_t **tree, FILE *file);
+bool bst_flat_save(bst_flat_t *flat, FILE *file);
+bool bst_flat_map(bst_flat_t *flat, FILE *file);
+
+// Parametr α automatického vyvažování, 0 vyvažování vypíná
+extern double bst_alpha;
+
+void bst_rebuild(bst_node_t **tree);
+void bst_scapegoat(bst_node_t **tree, char key, int depth);
 void bst_balance(bst_node_t **tree);
+void bst_balance_dsw(bst_node_t **tree);
 void letter_count(bst_node_t **letter_frequency_tree, char *input);
+void letter_count_parallel(bst_node_t **letter_frequency_tree, char *input, int threads);
+void letter_count_add(bst_node_t **letter_frequency_tree, char *input);
+void letter_count_subtract(bst_node_t **letter_frequency_tree, char *input);
+bool letter_count_file(bst_node_t **letter_frequency_tree, FILE *file);
+bool letter_count_map(bst_node_t **letter_frequency_tree, FILE *file);
 
 #endif
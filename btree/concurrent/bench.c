@@ -0,0 +1,117 @@
+/*
+ * Propustnost souběžného stromu v závislosti na počtu vláken a podílu čtení.
+ *
+ * Pro srovnání se měří i rekurzivní varianta binárního stromu chráněná
+ * jediným zámkem. Každé vlákno provede stejný počet náhodných operací nad
+ * všemi 256 klíči. Výstupem jsou řádky CSV ve tvaru engine,operace,počet
+ * operací,ns/op,op/s, kde engine obsahuje počet vláken a operace podíl
+ * čtení v procentech.
+ */
+
+#include "concurrent.h"
+#include "../btree.h"
+#include "../bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+
+#define MAX_THREADS 16
+
+typedef struct bench_thread {
+  bool locked;          // use the global mutex tree instead of the concurrent one
+  int read_percent;
+  int ops;
+  unsigned seed;
+  long long sum;
+} bench_thread_t;
+
+bst_conc_t conc_tree;
+bst_node_t *locked_tree;
+mtx_t tree_lock;
+
+volatile long long sink = 0;
+
+int run_thread(void *arg) {
+  bench_thread_t *thread = arg;
+  unsigned state = thread->seed;
+  for (int i = 0; i < thread->ops; i++) {
+    unsigned random = bench_random(&state);
+    char key = (char)random;
+    bool read = (int)((random >> 8) % 100) < thread->read_percent;
+    bool insert = (random >> 16) & 1;
+    int value;
+    if (thread->locked) {
+      mtx_lock(&tree_lock);
+      if (read) {
+        if (bst_search(locked_tree, key, &value)) thread->sum += value;
+      } else if (insert) {
+        bst_insert(&locked_tree, key, i);
+      } else {
+        bst_delete(&locked_tree, key);
+      }
+      mtx_unlock(&tree_lock);
+    } else {
+      if (read) {
+        if (bst_conc_search(&conc_tree, key, &value)) thread->sum += value;
+      } else if (insert) {
+        bst_conc_insert(&conc_tree, key, i);
+      } else {
+        bst_conc_delete(&conc_tree, key);
+      }
+    }
+  }
+  return 0;
+}
+
+void bench_run(bool locked, int threads, int read_percent, int ops) {
+  bst_conc_init(&conc_tree);
+  bst_init(&locked_tree);
+  // even keys inserted in bit-reversed order, so both trees start balanced
+  for (int i = 0; i < 128; i++) {
+    int reversed = 0;
+    for (int bit = 0; bit < 8; bit++) {
+      reversed |= ((i >> bit) & 1) << (7 - bit);
+    }
+    bst_conc_insert(&conc_tree, (char)(reversed - 128), reversed);
+    bst_insert(&locked_tree, (char)(reversed - 128), reversed);
+  }
+
+  thrd_t handles[MAX_THREADS];
+  bench_thread_t params[MAX_THREADS];
+  long long start = bench_start();
+  for (int i = 0; i < threads; i++) {
+    params[i] = (bench_thread_t){locked, read_percent, ops, 2463534242u + i * 7919u, 0};
+    thrd_create(&handles[i], run_thread, &params[i]);
+  }
+  for (int i = 0; i < threads; i++) {
+    thrd_join(handles[i], NULL);
+    sink += params[i].sum;
+  }
+  long long elapsed = bench_now_ns() - start;
+
+  char engine[32], operation[32];
+  snprintf(engine, sizeof(engine), "%s-%dt", locked ? "mutex" : "concurrent", threads);
+  snprintf(operation, sizeof(operation), "read_%d", read_percent);
+  bench_report(engine, operation, (long long)ops * threads, elapsed);
+
+  bst_conc_dispose(&conc_tree);
+  bst_dispose(&locked_tree);
+}
+
+int main(int argc, char *argv[]) {
+  int ops = argc > 1 ? atoi(argv[1]) : 1000000;
+  int max_threads = argc > 2 ? atoi(argv[2]) : 8;
+  if (max_threads > MAX_THREADS) max_threads = MAX_THREADS;
+  const int read_percents[] = {100, 95, 80, 50, 0};
+
+  mtx_init(&tree_lock, mtx_plain);
+  printf("engine,operation,ops,ns_per_op,ops_per_s%s\n", bench_perf_columns());
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    for (int i = 0; i < 5; i++) {
+      bench_run(false, threads, read_percents[i], ops);
+      bench_run(true, threads, read_percents[i], ops);
+    }
+  }
+  mtx_destroy(&tree_lock);
+  return 0;
+}
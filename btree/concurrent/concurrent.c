@@ -0,0 +1,202 @@
+/*
+ * Binární vyhledávací strom se souběžným přístupem více vláken.
+ *
+ * Každý uzel má vlastní verzi, která slouží jako zámek (lichá hodnota) a
+ * zároveň jako počitadlo změn. Vyhledávání nic nezamyká: přečte verzi uzlu,
+ * jeho hodnotu a znovu verzi, a pokud se verze mezitím změnila, čtení
+ * zopakuje. Změna hodnoty i odstranění zamyká pouze měněný uzel.
+ *
+ * Odstranění je pouze logické, uzel zůstane ve stromu označený jako
+ * nepřítomný a opětovné vložení klíče jej oživí. Struktura stromu tedy jen
+ * roste (ukazatel na potomka se mění pouze z NULL na nový uzel) a klíč uzlu
+ * se nikdy nemění, takže sestup stromem nemusí nic ověřovat a žádný uzel se
+ * neuvolňuje, dokud jej jiné vlákno může číst. Klíčů typu char je nejvýše
+ * 256, a tedy i odstraněných uzlů zůstává ve stromu nejvýše 256.
+ */
+
+#include "concurrent.h"
+#include <stdlib.h>
+#include <threads.h>
+
+// Function to wait until the node is unlocked, returns its even version
+unsigned readVersion(bst_cnode_t *node)
+{
+  unsigned version;
+
+  while((version = atomic_load_explicit(&node->version, memory_order_acquire)) & 1)
+  {
+    thrd_yield();                                 // writer holds the node
+  }
+
+  return version;
+}
+
+// Function to check that nothing was written to the node since version was read
+bool validateVersion(bst_cnode_t *node, unsigned version)
+{
+  atomic_thread_fence(memory_order_acquire);      // reads of the fields may not move past the check
+  return atomic_load_explicit(&node->version, memory_order_relaxed) == version;
+}
+
+// Function to lock the node for writing
+void lockNode(bst_cnode_t *node)
+{
+  unsigned version = readVersion(node);
+
+  while(!atomic_compare_exchange_weak_explicit(&node->version, &version, version + 1,
+                                               memory_order_acquire, memory_order_relaxed))
+  {
+    version = readVersion(node);                  // another writer was faster
+  }
+
+  atomic_thread_fence(memory_order_release);      // readers must see the odd version before any new field
+}
+
+// Function to unlock the node, the version moves to the next even number
+void unlockNode(bst_cnode_t *node)
+{
+  atomic_fetch_add_explicit(&node->version, 1, memory_order_release);
+}
+
+// Function to find the node with key, removed nodes are found too, returns NULL if there is none
+bst_cnode_t *findNode(bst_conc_t *tree, char key)
+{
+  bst_cnode_t *node = atomic_load_explicit(&tree->root, memory_order_acquire);
+
+  while(node && node->key != key)
+  {
+    node = atomic_load_explicit(key < node->key ? &node->left : &node->right, memory_order_acquire);
+  }
+
+  return node;
+}
+
+// Function to store value to the node and mark its key as present
+void updateNode(bst_cnode_t *node, int value)
+{
+  lockNode(node);
+  atomic_store_explicit(&node->value, value, memory_order_relaxed);
+  atomic_store_explicit(&node->present, true, memory_order_relaxed);
+  unlockNode(node);
+}
+
+/*
+ * Inicializace stromu.
+ */
+void bst_conc_init(bst_conc_t *tree) {
+  atomic_init(&tree->root, NULL);
+}
+
+/*
+ * Vyhledání uzlu ve stromu.
+ *
+ * Návratová hodnota a value jako u bst_search. Funkci lze volat souběžně
+ * s libovolnými dalšími operacemi, nikdy nečeká na zámek sestupu, pouze
+ * opakuje čtení uzlu, do kterého se právě zapisuje.
+ */
+bool bst_conc_search(bst_conc_t *tree, char key, int *value) {
+  bst_cnode_t *node = findNode(tree, key);
+  if(!node) return false;
+
+  bool present;
+  int found;
+  unsigned version;
+
+  do
+  {
+    version = readVersion(node);
+    present = atomic_load_explicit(&node->present, memory_order_relaxed);
+    found = atomic_load_explicit(&node->value, memory_order_relaxed);
+  } while(!validateVersion(node, version));     // value and presence must come from the same write
+
+  if(present)
+  {
+    *value = found;
+  }
+
+  return present;
+}
+
+/*
+ * Vložení uzlu do stromu.
+ *
+ * Nový uzel se připojí jedinou atomickou záměnou ukazatele NULL na potomka
+ * bez zamykání. Pokud klíč již ve stromu je, uzel se zamkne a změní se jeho
+ * hodnota. Při nedostatku paměti zůstane strom beze změny.
+ */
+void bst_conc_insert(bst_conc_t *tree, char key, int value) {
+  _Atomic(bst_cnode_t *) *link = &tree->root;
+  bst_cnode_t *node = NULL;                       // allocated only when an empty link is reached
+
+  while(true)
+  {
+    bst_cnode_t *current = atomic_load_explicit(link, memory_order_acquire);
+
+    if(!current)
+    {
+      if(!node)
+      {
+        node = malloc(sizeof(bst_cnode_t));
+        if(!node) return;                         // allocation check
+
+        node->key = key;
+        atomic_init(&node->value, value);
+        atomic_init(&node->present, true);
+        atomic_init(&node->version, 0);
+        atomic_init(&node->left, NULL);
+        atomic_init(&node->right, NULL);
+      }
+
+      if(atomic_compare_exchange_strong_explicit(link, &current, node,
+                                                 memory_order_release, memory_order_acquire))
+      {
+        return;                                   // node is linked and visible to other threads
+      }
+      // another thread linked its node first, current now holds it and we continue from there
+    }
+
+    if(current->key == key)
+    {
+      free(node);                                 // key appeared meanwhile, the spare node is not needed
+      updateNode(current, value);
+      return;
+    }
+
+    link = key < current->key ? &current->left : &current->right;
+  }
+}
+
+/*
+ * Odstranění uzlu ze stromu.
+ *
+ * Uzel se zamkne a označí jako nepřítomný, ze stromu se nevyjímá.
+ */
+void bst_conc_delete(bst_conc_t *tree, char key) {
+  bst_cnode_t *node = findNode(tree, key);
+  if(!node) return;
+
+  lockNode(node);
+  atomic_store_explicit(&node->present, false, memory_order_relaxed);
+  unlockNode(node);
+}
+
+// Function to free the subtree
+void disposeSubtree(bst_cnode_t *node)
+{
+  if(!node) return;
+
+  disposeSubtree(atomic_load_explicit(&node->left, memory_order_relaxed));
+  disposeSubtree(atomic_load_explicit(&node->right, memory_order_relaxed));
+  free(node);
+}
+
+/*
+ * Zrušení stromu.
+ *
+ * Funkci lze volat až poté, co strom přestala používat všechna ostatní
+ * vlákna. Po zrušení se strom nachází ve stejném stavu jako po inicializaci.
+ */
+void bst_conc_dispose(bst_conc_t *tree) {
+  disposeSubtree(atomic_load_explicit(&tree->root, memory_order_relaxed));
+  atomic_store_explicit(&tree->root, NULL, memory_order_relaxed);
+}
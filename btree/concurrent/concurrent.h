@@ -0,0 +1,32 @@
+/*
+ * Hlavičkový soubor pro binární vyhledávací strom se souběžným přístupem.
+ */
+
+#ifndef IAL_BTREE_CONCURRENT_H
+#define IAL_BTREE_CONCURRENT_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+// Uzel stromu
+typedef struct bst_cnode {
+  char key;                           // klíč, po vložení uzlu se nemění
+  atomic_int value;                   // hodnota
+  atomic_bool present;                // false u odstraněného klíče
+  atomic_uint version;                // lichá hodnota znamená zamčený uzel
+  _Atomic(struct bst_cnode *) left;   // levý potomek
+  _Atomic(struct bst_cnode *) right;  // pravý potomek
+} bst_cnode_t;
+
+// Strom
+typedef struct bst_conc {
+  _Atomic(bst_cnode_t *) root;        // kořen
+} bst_conc_t;
+
+void bst_conc_init(bst_conc_t *tree);
+bool bst_conc_search(bst_conc_t *tree, char key, int *value);
+void bst_conc_insert(bst_conc_t *tree, char key, int value);
+void bst_conc_delete(bst_conc_t *tree, char key);
+void bst_conc_dispose(bst_conc_t *tree);
+
+#endif
@@ -0,0 +1,109 @@
+#include "concurrent.h"
+#include "../test_check.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+
+// Number of writer and reader threads and the rounds of each writer
+#define WRITERS 4
+#define READERS 4
+#define ROUNDS 200
+
+bst_conc_t shared;
+atomic_int writers_running;
+
+// Writer i owns the keys congruent to i modulo WRITERS, the value always encodes the key
+int writer(void *arg) {
+  int first = *(int *)arg;
+  for (int round = 0; round < ROUNDS; round++) {
+    for (int key = -128 + first; key < 128; key += WRITERS) {
+      if (round % 2 == 0) {
+        bst_conc_insert(&shared, (char)key, round * 256 + (key & 0xFF));
+      } else {
+        bst_conc_delete(&shared, (char)key);
+      }
+    }
+  }
+  atomic_fetch_sub(&writers_running, 1);
+  return 0;
+}
+
+int reader(void *arg) {
+  int *failures = arg;
+  while (atomic_load(&writers_running) > 0) {
+    for (int key = -128; key < 128; key++) {
+      int value;
+      if (bst_conc_search(&shared, (char)key, &value) &&
+          (value & 0xFF) != (key & 0xFF)) {
+        (*failures)++;
+      }
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  printf("Concurrent Binary Search Tree - testing script\n");
+  printf("----------------------------------------------\n\n");
+
+  bst_conc_t tree;
+  bst_conc_init(&tree);
+
+  printf("[test_conc_insert_many] Insert many values\n");
+  for (int i = 0; i < base_data_count; i++) {
+    bst_conc_insert(&tree, base_keys[i], base_values[i]);
+  }
+  int result;
+  check(bst_conc_search(&tree, 'A', &result) && result == 1 &&
+            !bst_conc_search(&tree, 'X', &result),
+        "Node A was found and node X was not");
+
+  printf("[test_conc_delete] Delete a node with both subtrees (L)\n");
+  bst_conc_delete(&tree, 'L');
+  check(!bst_conc_search(&tree, 'L', &result) &&
+            bst_conc_search(&tree, 'K', &result) && result == 11,
+        "Node L was deleted and node K is still found");
+
+  printf("[test_conc_reinsert] Insert the deleted node again (L,120)\n");
+  bst_conc_insert(&tree, 'L', 120);
+  check(bst_conc_search(&tree, 'L', &result) && result == 120,
+        "Node L was found with the new value");
+  bst_conc_dispose(&tree);
+
+  printf("[test_conc_threads] Insert and delete from %d threads while %d "
+         "threads search\n",
+         WRITERS, READERS);
+  bst_conc_init(&shared);
+  atomic_init(&writers_running, WRITERS);
+  thrd_t threads[WRITERS + READERS];
+  int firsts[WRITERS];
+  int failures[READERS] = {0};
+  for (int i = 0; i < WRITERS; i++) {
+    firsts[i] = i;
+    thrd_create(&threads[i], writer, &firsts[i]);
+  }
+  for (int i = 0; i < READERS; i++) {
+    thrd_create(&threads[WRITERS + i], reader, &failures[i]);
+  }
+  for (int i = 0; i < WRITERS + READERS; i++) {
+    thrd_join(threads[i], NULL);
+  }
+  int total_failures = 0;
+  for (int i = 0; i < READERS; i++) {
+    total_failures += failures[i];
+  }
+  // the last round of every writer deletes its keys
+  bool all_deleted = true;
+  for (int key = -128; key < 128; key++) {
+    if (bst_conc_search(&shared, (char)key, &result)) {
+      all_deleted = false;
+    }
+  }
+  bst_conc_insert(&shared, 'Q', 17);
+  check(total_failures == 0 && all_deleted &&
+            bst_conc_search(&shared, 'Q', &result) && result == 17,
+        "Every value matched its key and all keys ended deleted");
+  bst_conc_dispose(&shared);
+
+  return tests_summary();
+}
@@ -0,0 +1,207 @@
+/*
+ * Uspořádaná mapa klíčů typu char přímo indexovaná klíčem.
+ *
+ * Klíčů typu char je nejvýše 256, hodnoty proto leží v poli indexovaném
+ * klíčem a přítomnost klíčů určují bity 256bitové mapy. Vložení,
+ * vyhledání i odstranění jsou jediný přístup do pole a změna jednoho bitu.
+ * Pořadí a výběr k-tého klíče se počítají z počtu nastavených bitů ve
+ * čtyřech slovech mapy a následník z počtu nulových bitů za pozicí, takže
+ * žádná operace neprochází ukazatele a celá mapa zabírá 1056 bajtů.
+ */
+
+#include "btree.h"
+#include <limits.h>
+
+// Function to get the array index of the key, indices follow the order of keys also for signed char
+int denseIndex(char key)
+{
+  return (int)key - CHAR_MIN;
+}
+
+// Function to get the key of the array index
+char denseKey(int index)
+{
+  return (char)(index + CHAR_MIN);
+}
+
+// Function to get the index of the first present key at index or above, returns -1 if there is none
+int denseFirstFrom(bst_dense_t *dense, int index)
+{
+  if(index >= 256) return -1;
+
+  int word = index / 64;
+  uint64_t bits = dense->present[word] & (~0ull << (index % 64)); // we drop the keys below index
+
+  while(!bits)
+  {
+    if(++word == 4) return -1;
+    bits = dense->present[word];
+  }
+
+  return word * 64 + __builtin_ctzll(bits);
+}
+
+/*
+ * Inicializace mapy.
+ */
+void bst_dense_init(bst_dense_t *dense) {
+  for(int i = 0; i < 4; i++)
+  {
+    dense->present[i] = 0;
+  }
+}
+
+/*
+ * Vložení hodnoty do mapy.
+ *
+ * Pokud klíč v mapě již je, jeho hodnota se nahradí.
+ */
+void bst_dense_insert(bst_dense_t *dense, char key, int value) {
+  int index = denseIndex(key);
+  dense->values[index] = value;
+  dense->present[index / 64] |= 1ull << (index % 64);
+}
+
+/*
+ * Vyhledání klíče v mapě.
+ *
+ * Pokud je klíč nalezen, vrací true a hodnotu uloží do value.
+ */
+bool bst_dense_search(bst_dense_t *dense, char key, int *value) {
+  int index = denseIndex(key);
+  if(!(dense->present[index / 64] >> (index % 64) & 1)) return false;
+
+  *value = dense->values[index];
+  return true;
+}
+
+/*
+ * Odstranění klíče z mapy.
+ *
+ * Pokud klíč v mapě není, funkce nic nedělá.
+ */
+void bst_dense_delete(bst_dense_t *dense, char key) {
+  int index = denseIndex(key);
+  dense->present[index / 64] &= ~(1ull << (index % 64));
+}
+
+/*
+ * Počet klíčů mapy.
+ */
+int bst_dense_size(bst_dense_t *dense) {
+  int size = 0;
+  for(int i = 0; i < 4; i++)
+  {
+    size += __builtin_popcountll(dense->present[i]);
+  }
+  return size;
+}
+
+/*
+ * Pořadí klíče.
+ *
+ * Vrací počet klíčů mapy, které jsou menší než key, stejně jako bst_rank.
+ */
+int bst_dense_rank(bst_dense_t *dense, char key) {
+  int index = denseIndex(key);
+  int word = index / 64;
+  int rank = 0;
+
+  for(int i = 0; i < word; i++)                   // whole words below the key
+  {
+    rank += __builtin_popcountll(dense->present[i]);
+  }
+
+  uint64_t below = (1ull << (index % 64)) - 1;
+  return rank + __builtin_popcountll(dense->present[word] & below);
+}
+
+/*
+ * Výběr k-tého nejmenšího klíče.
+ *
+ * Pořadí k se počítá od nuly jako u bst_select. Pokud k-tý klíč existuje,
+ * vrací true a klíč uloží do key.
+ */
+bool bst_dense_select(bst_dense_t *dense, int k, char *key) {
+  if(k < 0) return false;
+
+  for(int word = 0; word < 4; word++)
+  {
+    uint64_t bits = dense->present[word];
+    int count = __builtin_popcountll(bits);
+
+    if(k >= count)                                // k-th key is in a later word
+    {
+      k -= count;
+      continue;
+    }
+
+    while(k-- > 0)
+    {
+      bits &= bits - 1;                           // we clear the k smaller keys of the word
+    }
+    *key = denseKey(word * 64 + __builtin_ctzll(bits));
+    return true;
+  }
+
+  return false;
+}
+
+/*
+ * Následník klíče.
+ *
+ * Pokud mapa obsahuje klíč větší než key, vrací true a nejmenší takový
+ * klíč uloží do next. Klíč key v mapě být nemusí.
+ */
+bool bst_dense_next(bst_dense_t *dense, char key, char *next) {
+  int index = denseFirstFrom(dense, denseIndex(key) + 1);
+  if(index < 0) return false;
+
+  *next = denseKey(index);
+  return true;
+}
+
+/*
+ * Průchod klíči v rozsahu <lo, hi>.
+ *
+ * Funkce visit se zavolá pro každý klíč rozsahu vzestupně podle klíče.
+ * Funkce visit nesmí měnit mapu.
+ */
+void bst_dense_range(bst_dense_t *dense, char lo, char hi, bst_dense_visitor_t visit, void *data) {
+  int start = denseIndex(lo);
+  int end = denseIndex(hi);
+
+  for(int word = start / 64; word <= end / 64; word++)
+  {
+    uint64_t bits = dense->present[word];
+    if(word == start / 64) bits &= ~0ull << (start % 64);      // we drop the keys below lo
+    if(word == end / 64) bits &= ~0ull >> (63 - end % 64);     // and the keys above hi
+
+    for(; bits; bits &= bits - 1)                 // every step clears the smallest present key
+    {
+      int index = word * 64 + __builtin_ctzll(bits);
+      visit(denseKey(index), dense->values[index], data);
+    }
+  }
+}
+
+// Function to insert all nodes of the subtree into the map
+void insertDense(bst_dense_t *dense, bst_node_t *node)
+{
+  if(!node) return;
+
+  bst_dense_insert(dense, node->key, node->value);
+  insertDense(dense, node->left);
+  insertDense(dense, node->right);
+}
+
+/*
+ * Sestavení mapy ze stromu.
+ *
+ * Mapa obsahuje stejné dvojice klíč a hodnota jako strom, strom zůstává
+ * beze změny. Předchozí obsah mapy se nepoužívá.
+ */
+void bst_dense_from_tree(bst_dense_t *dense, bst_node_t *tree) {
+  bst_dense_init(dense);
+  insertDense(dense, tree);
+}
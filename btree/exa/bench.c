@@ -0,0 +1,147 @@
+/*
+ * Porovnání vyhledávání v obyčejném, vyváženém a splay stromu a počítání
+ * znaků v jednom a více vláknech.
+ *
+ * Strom obsahuje všech 256 klíčů typu char vložených v náhodném pořadí.
+ * Vyhledávané klíče mají Zipfovo rozdělení (několik klíčů tvoří většinu
+ * dotazů) nebo rovnoměrné rozdělení pro srovnání. Znaky se počítají
+ * v textu o stejné délce jako počet dotazů, v paměti i v dočasném souboru.
+ * Program se sestavuje zvlášť s rekurzivní a iterativní variantou stromu
+ * (make bench). Výstupem jsou řádky CSV ve tvaru engine,operace,počet
+ * operací,ns/op,op/s.
+ */
+
+#include "../btree.h"
+#include "../bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef BENCH_BST
+#define BENCH_BST "btree"
+#endif
+
+#define KEY_COUNT 256
+
+volatile long long sink = 0;
+
+void build_tree(bst_node_t **tree, const char *order, bool splay) {
+  bst_init(tree);
+  for (int i = 0; i < KEY_COUNT; i++) {
+    if (splay) {
+      bst_splay_insert(tree, order[i], i);
+    } else {
+      bst_insert(tree, order[i], i);
+    }
+  }
+}
+
+void bench_search(const char *engine, const char *operation, bst_node_t **tree,
+                  const char *queries, int n, bool splay) {
+  long long start = bench_start();
+  for (int i = 0; i < n; i++) {
+    int value;
+    bool found = splay ? bst_splay_search(tree, queries[i], &value)
+                       : bst_search(*tree, queries[i], &value);
+    if (found) {
+      sink += value;
+    }
+  }
+  bench_report(engine, operation, n, bench_now_ns() - start);
+}
+
+void bench_engine(const char *engine, const char *order, const char *zipf_queries,
+                  const char *uniform_queries, int n, bool balance, bool splay) {
+  bst_node_t *tree;
+  build_tree(&tree, order, splay);
+  if (balance) {
+    bst_balance(&tree);
+  }
+  bench_search(engine, "zipf_search", &tree, zipf_queries, n, splay);
+  bench_search(engine, "uniform_search", &tree, uniform_queries, n, splay);
+  bst_dispose(&tree);
+}
+
+void bench_letter_count(const char *engine, char *text, int n, int threads) {
+  char operation[32];
+  bst_node_t *tree;
+  long long start = bench_start();
+  if (threads == 0) {
+    letter_count(&tree, text);
+    snprintf(operation, sizeof(operation), "letter_count");
+  } else {
+    letter_count_parallel(&tree, text, threads);
+    snprintf(operation, sizeof(operation), "letter_count_%dt", threads);
+  }
+  bench_report(engine, operation, n, bench_now_ns() - start);
+  sink += bst_size(tree);
+  bst_dispose(&tree);
+}
+
+void bench_letter_count_file(const char *engine, FILE *file, int n, bool map) {
+  bst_node_t *tree;
+  rewind(file);
+  long long start = bench_start();
+  if (map ? letter_count_map(&tree, file) : letter_count_file(&tree, file)) {
+    bench_report(engine, map ? "letter_count_map" : "letter_count_file", n,
+                 bench_now_ns() - start);
+  }
+  sink += bst_size(tree);
+  bst_dispose(&tree);
+}
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (n < 1) n = 1;
+  char *zipf_queries = malloc(n);
+  char *uniform_queries = malloc(n);
+  char *text = malloc(n + 1);
+  if (!zipf_queries || !uniform_queries || !text) return 1;
+
+  unsigned state = 2463534242u;
+  char order[KEY_COUNT];
+  for (int i = 0; i < KEY_COUNT; i++) {
+    order[i] = (char)i;
+  }
+  for (int i = KEY_COUNT - 1; i > 0; i--) {
+    int j = bench_random(&state) % (i + 1);
+    char tmp = order[i];
+    order[i] = order[j];
+    order[j] = tmp;
+  }
+
+  // hot keys are spread over the whole key range, rank r maps to order[r]
+  bench_zipf_t zipf;
+  if (!bench_zipf_init(&zipf, KEY_COUNT)) return 1;
+  for (int i = 0; i < n; i++) {
+    zipf_queries[i] = order[bench_zipf(&zipf, &state)];
+    uniform_queries[i] = (char)bench_random(&state);
+    text[i] = (char)(' ' + bench_random(&state) % 95); // printable ASCII
+  }
+  text[n] = '\0';
+  bench_zipf_dispose(&zipf);
+
+  printf("engine,operation,ops,ns_per_op,ops_per_s%s\n", bench_perf_columns());
+  bench_engine(BENCH_BST, order, zipf_queries, uniform_queries, n, false, false);
+  bench_engine(BENCH_BST "-balanced", order, zipf_queries, uniform_queries, n,
+               true, false);
+  bench_engine(BENCH_BST "-splay", order, zipf_queries, uniform_queries, n,
+               false, true);
+  // zero threads means the serial letter_count
+  int thread_counts[] = {0, 1, 2, 4};
+  for (int i = 0; i < 4; i++) {
+    bench_letter_count(BENCH_BST, text, n, thread_counts[i]);
+  }
+  FILE *file = tmpfile();
+  if (file != NULL && fwrite(text, 1, n, file) == (size_t)n && fflush(file) == 0) {
+    bench_letter_count_file(BENCH_BST, file, n, false);
+    bench_letter_count_file(BENCH_BST, file, n, true);
+  }
+  if (file != NULL) {
+    fclose(file);
+  }
+
+  free(zipf_queries);
+  free(text);
+  free(uniform_queries);
+  return 0;
+}
@@ -8,10 +8,126 @@
  * 
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "../btree.h"
+#include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <threads.h>
+
+// Size of the buffer used by letter_count_file
+#ifndef LETTER_BUFFER_SIZE
+#define LETTER_BUFFER_SIZE (64 * 1024)
+#endif
+
+
+// Function to get the tree key of the byte: lowercase letter, space or '_' for anything else
+char letterKey(unsigned char byte)
+{
+    if(byte >= 'A' && byte <= 'Z') return byte + 32;       // convert to lowercase
+    if((byte >= 'a' && byte <= 'z') || byte == ' ') return byte;
+    return '_';
+}
+
+// Function to add the number of occurrences of every byte value of the input to bins
+void countBytes(const char *input, size_t length, size_t bins[])
+{
+    const unsigned char *bytes = (const unsigned char *)input;
+    size_t sub[4][UCHAR_MAX + 1] = {{0}};                   // neighbouring bytes go to different histograms,
+    size_t i = 0;                                           // so repeated bytes do not wait for each other's store
+
+    for(; i + 4 <= length; i += 4)
+    {
+        sub[0][bytes[i]]++;
+        sub[1][bytes[i + 1]]++;
+        sub[2][bytes[i + 2]]++;
+        sub[3][bytes[i + 3]]++;
+    }
+
+    for(; i < length; i++)
+    {
+        sub[0][bytes[i]]++;
+    }
+
+    for(int byte = 0; byte <= UCHAR_MAX; byte++)
+    {
+        bins[byte] += sub[0][byte] + sub[1][byte] + sub[2][byte] + sub[3][byte];
+    }
+}
 
+// Order in which the tree keys first occurred in the input
+typedef struct letter_order {
+    bool seen[UCHAR_MAX + 1];
+    char keys[UCHAR_MAX + 1];
+    int count;
+} letter_order_t;
+
+// Function to append the keys of the input not seen before, bins are the byte counts of this input only
+void orderKeys(letter_order_t *order, const char *input, size_t length, const size_t bins[])
+{
+    bool fresh[UCHAR_MAX + 1] = {false};
+    int missing = 0;
+
+    for(int byte = 0; byte <= UCHAR_MAX; byte++)            // the histogram tells if the input has new keys at all
+    {
+        unsigned char key = letterKey(byte);
+        if(bins[byte] && !order->seen[key] && !fresh[key])
+        {
+            fresh[key] = true;
+            missing++;
+        }
+    }
+
+    for(size_t i = 0; i < length && missing > 0; i++)      // the scan stops once every new key is found
+    {
+        unsigned char key = letterKey(input[i]);
+        if(fresh[key])
+        {
+            fresh[key] = false;
+            order->seen[key] = true;
+            order->keys[order->count++] = key;
+            missing--;
+        }
+    }
+}
+
+// Function to add the counts of the bins to the counts by tree key, the 256 bins fold into 28 keys
+void foldCounts(const size_t bins[], size_t counts[])
+{
+    for(int byte = 0; byte <= UCHAR_MAX; byte++)
+    {
+        counts[(unsigned char)letterKey(byte)] += bins[byte];
+    }
+}
+
+// Function to add the counts of the bins to the values in the tree, new keys are inserted in order of their first occurrence, sums saturate at INT_MAX
+void insertCounts(bst_node_t **tree, letter_order_t *order, const size_t bins[])
+{
+    size_t counts[UCHAR_MAX + 1] = {0};
+    foldCounts(bins, counts);
+
+    for(int i = 0; i < order->count; i++)                   // same insertion order gives the same tree as counting one by one
+    {
+        unsigned char key = order->keys[i];
+        int value = 0;
+        bst_search(*tree, key, &value);                     // we add to the existing count, if there is one
+        long long sum = value + (long long)counts[key];     // no input is long enough to overflow long long
+        bst_insert(tree, key, sum > INT_MAX ? INT_MAX : (int)sum);
+    }
+}
+
+// Function to insert the counts of the bins of the whole input into the tree
+void materializeCounts(bst_node_t **tree, const char *input, size_t length, size_t bins[])
+{
+    letter_order_t order = {{false}, {0}, 0};
+    orderKeys(&order, input, length, bins);
+    insertCounts(tree, &order, bins);
+}
 
 /**
  * Vypočítání frekvence výskytů znaků ve vstupním řetězci.
@@ -29,79 +145,230 @@
  * ' '     2
  * '_'     5
  * 
+ * Znaky se nejdříve spočítají do histogramu všech 256 hodnot bajtu a ten se
+ * převede na 28 klíčů stromu. Strom se sestaví až nakonec, klíče se do něj
+ * vkládají v pořadí prvního výskytu, takže má stejný tvar jako při
+ * započítávání znaků jeden po druhém.
+ * 
+ * Hodnoty uzlů jsou typu int, počet větší než INT_MAX se proto uloží jako
+ * INT_MAX.
+ * 
  * Pro implementaci si můžete v tomto souboru nadefinovat vlastní pomocné funkce.
 */
 void letter_count(bst_node_t **tree, char *input) {
     bst_init(tree);                                         // we initialize the tree
-    int index = 0;                                          // we initialize the counter
-    while(input[index] != '\0')
+
+    size_t length = strlen(input);                          // libc finds the terminator many bytes at a time
+    size_t bins[UCHAR_MAX + 1] = {0};
+    countBytes(input, length, bins);
+
+    materializeCounts(tree, input, length, bins);           // tree is built once, at the end
+}
+
+// Part of the input counted by one thread into its own bins
+typedef struct letter_chunk {
+    const char *input;
+    size_t length;
+    size_t bins[UCHAR_MAX + 1];
+} letter_chunk_t;
+
+// Function run by every counting thread
+int countChunk(void *arg)
+{
+    letter_chunk_t *chunk = arg;
+    countBytes(chunk->input, chunk->length, chunk->bins);
+    return 0;
+}
+
+/**
+ * Paralelní výpočet frekvence výskytů znaků ve vstupním řetězci.
+ *
+ * Výsledný strom je stejný jako po volání letter_count. Vstup se rozdělí na
+ * threads souvislých úseků, každé vlákno počítá do vlastního histogramu bez
+ * jakéhokoli sdílení a histogramy se na konci sečtou. Úsek, pro který se
+ * nepodaří vytvořit vlákno, se spočítá ve volajícím vlákně. Počty nad
+ * INT_MAX se uloží jako INT_MAX.
+ */
+void letter_count_parallel(bst_node_t **tree, char *input, int threads) {
+    bst_init(tree);
+
+    size_t length = strlen(input);
+    if(threads < 1) threads = 1;
+
+    letter_chunk_t *chunks = calloc(threads, sizeof(letter_chunk_t));
+    thrd_t *handles = malloc(sizeof(thrd_t) * threads);
+    bool *started = calloc(threads, sizeof(bool));
+    size_t bins[UCHAR_MAX + 1] = {0};
+
+    if(!chunks || !handles || !started)                     // allocation check, we count in this thread
     {
-        char currentChar = input[index];
-        if(currentChar >= 'A' && currentChar <= 'Z')        // if the character is A-Z
+        countBytes(input, length, bins);
+    }
+    else
+    {
+        for(int i = 0; i < threads; i++)
         {
-            currentChar += 32;                              // convert to lowercase
-        }
+            size_t start = length / threads * i;            // the last chunk takes the remainder
+            size_t end = i == threads - 1 ? length : length / threads * (i + 1);
+            chunks[i].input = input + start;
+            chunks[i].length = end - start;
 
-        if(currentChar >= 'a' && currentChar <= 'z')        // if the character is a-z
-        {
-            int value;
-            if(bst_search(*tree, currentChar, &value))      // if the character is already in the tree
+            if(i > 0)                                       // first chunk is counted by the calling thread
             {
-                bst_insert(tree, currentChar, value + 1);   // we increase the value
-            }
-            else
-            {
-                bst_insert(tree, currentChar, 1);           // we insert the character with value 1
+                started[i] = thrd_create(&handles[i], countChunk, &chunks[i]) == thrd_success;
             }
         }
-        else if(currentChar == ' ')                         // if the character is space
+
+        countChunk(&chunks[0]);
+
+        for(int i = 1; i < threads; i++)
         {
-            int value;
-            if(bst_search(*tree, currentChar, &value))      // if the character is already in the tree
+            if(started[i])
             {
-                bst_insert(tree, currentChar, value + 1);   // we increase the value
+                thrd_join(handles[i], NULL);
             }
             else
             {
-                bst_insert(tree, currentChar, 1);           // we insert the character with value 1
+                countChunk(&chunks[i]);
             }
         }
-        else                                                // if the character is not a-z or space
+
+        for(int i = 0; i < threads; i++)                    // addition of the bins does not depend on the split
         {
-            int value;
-            if(bst_search(*tree, '_', &value))              // if the character is already in the tree
-            {
-                bst_insert(tree, '_', value + 1);           // we increase the value
-            }
-            else
+            for(int byte = 0; byte <= UCHAR_MAX; byte++)
             {
-                bst_insert(tree, '_', 1);                   // we insert the character with value 1
+                bins[byte] += chunks[i].bins[byte];
             }
         }
-        index++;
     }
+
+    materializeCounts(tree, input, length, bins);
+
+    free(chunks);
+    free(handles);
+    free(started);
 }
 
-// Function to count the number of nodes in a binary search tree
-int countNodes(bst_node_t* root)
-{
-    if (root == NULL) return 0;                                     // if root is NULL, we return 0
-   
-    return 1 + countNodes(root->left) + countNodes(root->right);    // we recursively count nodes in left and right subtree
+/**
+ * Výpočet frekvence výskytů znaků v souboru čteném po blocích.
+ *
+ * Výsledný strom je stejný jako po volání letter_count nad obsahem souboru
+ * od aktuální pozice do konce, nulové bajty se započítají jako ostatní
+ * znaky. Soubor se čte do bufferu pevné velikosti LETTER_BUFFER_SIZE,
+ * spotřeba paměti tedy nezávisí na velikosti souboru, ani pro soubory větší
+ * než 2 GiB, kde se počty nad INT_MAX uloží jako INT_MAX. Vrací false při
+ * chybě čtení, strom pak zůstane prázdný.
+ */
+bool letter_count_file(bst_node_t **tree, FILE *file) {
+    bst_init(tree);
+
+    char *buffer = malloc(LETTER_BUFFER_SIZE);
+    if(!buffer) return false;
+
+    letter_order_t order = {{false}, {0}, 0};
+    size_t bins[UCHAR_MAX + 1] = {0};
+    size_t length;
+
+    while((length = fread(buffer, 1, LETTER_BUFFER_SIZE, file)) > 0)
+    {
+        size_t buffer_bins[UCHAR_MAX + 1] = {0};
+        countBytes(buffer, length, buffer_bins);
+        orderKeys(&order, buffer, length, buffer_bins);     // only buffers with new keys are scanned again
+
+        for(int byte = 0; byte <= UCHAR_MAX; byte++)
+        {
+            bins[byte] += buffer_bins[byte];
+        }
+    }
+
+    free(buffer);
+    if(ferror(file)) return false;
+
+    insertCounts(tree, &order, bins);
+    return true;
 }
 
-// Function to build a balanced binary search tree from a sorted array of nodes
-bst_node_t* buildTreeFromSortedArray(bst_items_t *items, int start, int end)
-{
-    if (start > end) return NULL;                                   // if start is greater than end, we return NULL
+/**
+ * Výpočet frekvence výskytů znaků v souboru namapovaném do paměti.
+ *
+ * Výsledný strom je stejný jako po volání letter_count_file nad celým
+ * souborem. Soubor se nekopíruje, znaky se počítají přímo z mapování
+ * a systém je upozorněn, že se bude číst sekvenčně, takže může stránky
+ * načítat dopředu a přečtené stránky uvolňovat. Soubor tak může být větší
+ * než operační paměť, počty nad INT_MAX se pak uloží jako INT_MAX. Vrací
+ * false, pokud soubor nelze namapovat, strom pak zůstane prázdný.
+ */
+bool letter_count_map(bst_node_t **tree, FILE *file) {
+    bst_init(tree);
+
+    struct stat info;
+    if(fstat(fileno(file), &info) != 0) return false;
+    if(info.st_size == 0) return true;                      // empty file cannot be mapped
+    if((uintmax_t)info.st_size > SIZE_MAX) return false;
+
+    size_t length = (size_t)info.st_size;
+    char *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if(map == MAP_FAILED) return false;
 
-    int mid = (start + end)/2;                                      // we get the middle element
-    bst_node_t *root = items->nodes[mid];                           // we set the middle element as root
-    
-    root->left  = buildTreeFromSortedArray(items, start, mid-1);    // we recursively build left and right subtree
-    root->right = buildTreeFromSortedArray(items, mid+1, end);      
+    posix_madvise(map, length, POSIX_MADV_SEQUENTIAL);      // the advice is only a hint, failure does not matter
 
-    return root;    
+    size_t bins[UCHAR_MAX + 1] = {0};
+    countBytes(map, length, bins);
+    materializeCounts(tree, map, length, bins);
+
+    munmap(map, length);
+    return true;
+}
+
+/**
+ * Přičtení frekvence výskytů znaků dalšího úseku vstupu ke stromu.
+ *
+ * Na rozdíl od letter_count strom neinicializuje, počty znaků úseku se
+ * přičtou k hodnotám již existujících uzlů a chybějící klíče se vloží
+ * v pořadí prvního výskytu. Strom po volání letter_count nad prvním úsekem
+ * a letter_count_add nad dalšími úseky je proto stejný jako po volání
+ * letter_count nad jejich spojením. Součet, který by přesáhl INT_MAX, se
+ * uloží jako INT_MAX. Strom musí být inicializovaný.
+ */
+void letter_count_add(bst_node_t **tree, char *input) {
+    size_t length = strlen(input);
+    size_t bins[UCHAR_MAX + 1] = {0};
+    countBytes(input, length, bins);
+
+    materializeCounts(tree, input, length, bins);
+}
+
+/**
+ * Odečtení frekvence výskytů znaků úseku vstupu od stromu.
+ *
+ * Slouží pro posuvné okno nad proudem dat: úsek, který z okna vypadl, se
+ * odečte a nový úsek se přičte funkcí letter_count_add, bez přepočítání
+ * celého okna. Uzel, jehož počet klesne na nulu, se ze stromu odstraní,
+ * klíče, které ve stromu nejsou, se ignorují. Strom pak obsahuje stejné
+ * dvojice klíč a hodnota jako strom spočítaný nad oknem znovu, jeho tvar
+ * se ale může lišit. To neplatí pro hodnotu nasycenou na INT_MAX, která už
+ * neodpovídá skutečnému počtu, odečtením z ní vznikne menší počet.
+ */
+void letter_count_subtract(bst_node_t **tree, char *input) {
+    size_t bins[UCHAR_MAX + 1] = {0};
+    size_t counts[UCHAR_MAX + 1] = {0};
+    countBytes(input, strlen(input), bins);
+    foldCounts(bins, counts);
+
+    for(int key = 0; key <= UCHAR_MAX; key++)               // order does not matter, no key is inserted
+    {
+        int value;
+        if(counts[key] == 0 || !bst_search(*tree, key, &value)) continue;
+
+        if(value > 0 && (size_t)value > counts[key])        // compared in size_t, counts above INT_MAX do not wrap
+        {
+            bst_insert(tree, key, value - (int)counts[key]);  // the count is below value, so it fits in int
+        }
+        else
+        {
+            bst_delete(tree, key);
+        }
+    }
 }
 
 /**
@@ -116,15 +383,55 @@ bst_node_t* buildTreeFromSortedArray(bst_items_t *items, int start, int end)
 */
 void bst_balance(bst_node_t **tree) {
 
-    bst_items_t items;    
-    items.capacity = countNodes(*tree);
-    items.nodes = malloc(sizeof(bst_node_t*) * items.capacity); // initialization and allocation 
-    items.size = 0;
+    bst_rebuild(tree);                                          // nodes are relinked from the inorder array, see ../btree.c
+}
+
+// Function to make count left rotations on every other node of the right spine
+void compressVine(bst_node_t **link, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        bst_rotate_left(link);                                      // node goes down left of its right child
+        link = &(*link)->right;                                     // we skip to the next pair
+    }
+}
+
+/**
+ * Vyvážení stromu na místě (Day–Stout–Warren).
+ *
+ * Strom se pravými rotacemi narovná do seznamu uzlů vedeného přes pravé
+ * potomky a ten se levými rotacemi každého druhého uzlu opakovaně zkracuje
+ * na polovinu, dokud nevznikne úplný strom. Funkce pracuje ve dvou
+ * lineárních průchodech s konstantní pomocnou pamětí, nic nealokuje a
+ * nevyužívá rekurzi ani zásobník.
+ */
+void bst_balance_dsw(bst_node_t **tree) {
 
-  
-    bst_inorder(*tree, &items);                                 // getting nodes from tree by inorder traversal
+    bst_node_t **link = tree;
+    while (*link)                                                   // tree to vine
+    {
+        if ((*link)->left)
+        {
+            bst_rotate_right(link);                                 // left child moves up onto the spine
+        }
+        else
+        {
+            link = &(*link)->right;                                 // spine is straight up to here
+        }
+    }
+
+    int count = bst_size(*tree);
+    int full = 1;
+    while (full * 2 + 1 <= count)                                   // full is the size of the largest complete tree that fits
+    {
+        full = full * 2 + 1;
+    }
 
-    *tree = buildTreeFromSortedArray(&items, 0, items.size-1);  // building balanced tree from sorted array of nodes
+    compressVine(tree, count - full);                               // extra nodes form the incomplete bottom level
 
-    free(items.nodes);                                          // cleaning after ourselves
-}
\ No newline at end of file
+    while (full > 1)                                                // vine to tree
+    {
+        full /= 2;
+        compressVine(tree, full);
+    }
+}
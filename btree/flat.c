@@ -0,0 +1,112 @@
+/*
+ * Statické vyhledávací pole v Eytzingerově (BFS) pořadí.
+ *
+ * Klíče seřazené průchodem inorder se uloží do jednoho pole tak, že kořen
+ * dokonale vyváženého stromu leží na indexu 1 a potomci uzlu na indexu i
+ * leží na indexech 2i a 2i+1. Vyhledávání je pak pouhý výpočet indexů bez
+ * ukazatelů a podmíněných skoků, horní úrovně stromu sdílí několik
+ * cache řádků a další úrovně lze přednačítat dopředu.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "btree.h"
+#include <stdlib.h>
+#include <sys/mman.h>
+
+// Function to fill the Eytzinger array from the sorted nodes, k is the index of the current subtree root
+void fillEytzinger(bst_items_t *items, int *next, int k, bst_flat_t *flat)
+{
+  if (k > flat->size) return;                               // if k is outside of the array, there is no subtree
+
+  fillEytzinger(items, next, 2 * k, flat);                  // left subtree takes the smaller keys
+
+  flat->keys[k]   = items->nodes[*next]->key;               // current index takes the next key in sorted order
+  flat->values[k] = items->nodes[*next]->value;
+  (*next)++;
+
+  fillEytzinger(items, next, 2 * k + 1, flat);              // right subtree takes the greater keys
+}
+
+/*
+ * Sestavení statického vyhledávacího pole ze stromu.
+ *
+ * Strom zůstává beze změny, pole je jeho nezávislou kopií a po změně stromu
+ * je nutné jej sestavit znovu. Typicky se volá po bst_balance nad stromem,
+ * který se dále jen prohledává. Předchozí obsah flat se nepoužívá.
+ */
+void bst_compile(bst_node_t *tree, bst_flat_t *flat) {
+  bst_items_t items;
+  items.capacity = 0;
+  items.nodes = NULL;
+  items.size = 0;
+
+  bst_inorder(tree, &items);                                    // getting sorted nodes by inorder traversal
+
+  flat->size = items.size;
+  flat->map = NULL;
+  flat->keys = malloc(sizeof(char) * (items.size + 1));         // index 0 is unused
+  flat->values = malloc(sizeof(int) * (items.size + 1));
+
+  if (!flat->keys || !flat->values)                             // allocation check
+  {
+    bst_flat_dispose(flat);
+  }
+  else
+  {
+    flat->keys[0] = 0;                                          // unused slot is saved by bst_flat_save as well
+    flat->values[0] = 0;
+    int next = 0;
+    fillEytzinger(&items, &next, 1, flat);
+  }
+
+  free(items.nodes);
+}
+
+/*
+ * Vyhledání klíče ve statickém poli.
+ *
+ * Sestup polem nevětví podle výsledku porovnání, pouze posouvá index.
+ * Po opuštění pole se z indexu odstraní kroky doprava provedené od
+ * posledního kroku doleva, čímž vznikne index nejmenšího klíče, který není
+ * menší než hledaný klíč. Návratová hodnota a value jako u bst_search.
+ */
+bool bst_flat_search(bst_flat_t *flat, char key, int *value) {
+  const char *keys = flat->keys;
+  int k = 1;
+
+  while (k <= flat->size)
+  {
+    __builtin_prefetch(keys + k * 16);                          // four levels below are 16 consecutive keys
+    k = 2 * k + (keys[k] < key);                                // we go left or right without branching
+  }
+
+  k >>= __builtin_ffs(~k);                                      // we cancel the trailing right turns
+
+  if (k == 0 || keys[k] != key) return false;                   // key is greater than all keys or it is missing
+
+  *value = flat->values[k];
+  return true;
+}
+
+/*
+ * Zrušení statického pole.
+ *
+ * Pole namapované funkcí bst_flat_map se odmapuje, jinak se uvolní.
+ */
+void bst_flat_dispose(bst_flat_t *flat) {
+  if(flat->map)
+  {
+    munmap(flat->map, flat->map_size);            // keys and values point into the mapping
+  }
+  else
+  {
+    free(flat->keys);
+    free(flat->values);
+  }
+  flat->map = NULL;
+  flat->map_size = 0;
+  flat->keys = NULL;
+  flat->values = NULL;
+  flat->size = 0;
+}
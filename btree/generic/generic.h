@@ -0,0 +1,205 @@
+/*
+ * Hlavičkový soubor pro binární vyhledávací strom s libovolným typem klíče.
+ */
+#ifndef IAL_BTREE_GENERIC_H
+#define IAL_BTREE_GENERIC_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+/*
+ * Makro generující deklarace pro strom s klíčem typu K, hodnotou typu V a
+ * názvovým prefixem NAME. Pro NAME=bst_i64, K=int64_t, V=double:
+ *   Datový typ bst_i64_node_t
+ *   Funkce void bst_i64_init(bst_i64_node_t **tree)
+ *          void bst_i64_insert(bst_i64_node_t **tree, int64_t key, double value)
+ *          bool bst_i64_search(bst_i64_node_t *tree, int64_t key, double *value)
+ *          void bst_i64_delete(bst_i64_node_t **tree, int64_t key)
+ *          void bst_i64_dispose(bst_i64_node_t **tree)
+ *          int bst_i64_size(bst_i64_node_t *tree)
+ *          int bst_i64_rank(bst_i64_node_t *tree, int64_t key)
+ *          bst_i64_node_t *bst_i64_select(bst_i64_node_t *tree, int k)
+ *          void bst_i64_for_each(bst_i64_node_t *tree,
+ *                                void (*visit)(bst_i64_node_t *node, void *data),
+ *                                void *data)
+ * Funkce se chovají stejně jako jejich protějšky pro klíče typu char.
+ */
+#define BSTDEC(K, V, NAME)                                                     \
+  typedef struct NAME##_node {                                                 \
+    K key;                                                                     \
+    V value;                                                                   \
+    int size;                                                                  \
+    struct NAME##_node *left;                                                  \
+    struct NAME##_node *right;                                                 \
+  } NAME##_node_t;                                                             \
+                                                                               \
+  void NAME##_init(NAME##_node_t **tree);                                      \
+  void NAME##_insert(NAME##_node_t **tree, K key, V value);                    \
+  bool NAME##_search(NAME##_node_t *tree, K key, V *value);                    \
+  void NAME##_delete(NAME##_node_t **tree, K key);                             \
+  void NAME##_dispose(NAME##_node_t **tree);                                   \
+  int NAME##_size(NAME##_node_t *tree);                                        \
+  int NAME##_rank(NAME##_node_t *tree, K key);                                 \
+  NAME##_node_t *NAME##_select(NAME##_node_t *tree, int k);                    \
+  void NAME##_for_each(NAME##_node_t *tree,                                    \
+                       void (*visit)(NAME##_node_t *node, void *data),         \
+                       void *data);
+
+/*
+ * Makro generující implementaci funkcí stromu deklarovaného makrem BSTDEC.
+ * CMP(a, b) je funkce nebo makro, které pro klíče typu K vrací záporné
+ * číslo, nulu nebo kladné číslo podle toho, zda je a menší, rovno, nebo
+ * větší než b. Implementace je vygenerovaná pro konkrétní typy, porovnání
+ * se tedy může vložit přímo do kódu a žádná hodnota se nepředává přes
+ * ukazatel void *.
+ *
+ * Všechny operace jsou iterativní a nepoužívají zásobník, hloubka stromu
+ * tedy není omezena. Funkce for_each prochází strom v pořadí inorder
+ * Morrisovým průchodem, během kterého dočasně mění prázdné pravé ukazatele
+ * uzlů, funkce visit proto nesmí číst ani měnit potomky uzlů.
+ */
+#define BSTDEF(K, V, NAME, CMP)                                                \
+  void NAME##_init(NAME##_node_t **tree) { *tree = NULL; }                     \
+                                                                               \
+  int NAME##_size(NAME##_node_t *tree) { return tree ? tree->size : 0; }      \
+                                                                               \
+  bool NAME##_search(NAME##_node_t *tree, K key, V *value) {                   \
+    while (tree) {                                                             \
+      int order = CMP(key, tree->key);                                         \
+      if (order == 0) {                                                        \
+        *value = tree->value;                                                  \
+        return true;                                                           \
+      }                                                                        \
+      tree = order < 0 ? tree->left : tree->right;                             \
+    }                                                                          \
+    return false;                                                              \
+  }                                                                            \
+                                                                               \
+  void NAME##_insert(NAME##_node_t **tree, K key, V value) {                   \
+    NAME##_node_t **link = tree;                                               \
+    while (*link) {                                                            \
+      int order = CMP(key, (*link)->key);                                      \
+      if (order == 0) {                                                        \
+        (*link)->value = value;                                                \
+        return;                                                                \
+      }                                                                        \
+      link = order < 0 ? &(*link)->left : &(*link)->right;                     \
+    }                                                                          \
+    NAME##_node_t *node = malloc(sizeof(NAME##_node_t));                       \
+    if (!node) {                                                               \
+      return;                                                                  \
+    }                                                                          \
+    node->key = key;                                                           \
+    node->value = value;                                                       \
+    node->size = 1;                                                            \
+    node->left = NULL;                                                         \
+    node->right = NULL;                                                        \
+    *link = node;                                                              \
+    for (NAME##_node_t *current = *tree; current != node;) {                   \
+      current->size++;                                                         \
+      current = CMP(key, current->key) < 0 ? current->left : current->right;   \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void NAME##_delete(NAME##_node_t **tree, K key) {                            \
+    V value;                                                                   \
+    if (!NAME##_search(*tree, key, &value)) {                                  \
+      return;                                                                  \
+    }                                                                          \
+    NAME##_node_t **link = tree;                                               \
+    int order;                                                                 \
+    while ((order = CMP(key, (*link)->key)) != 0) {                            \
+      (*link)->size--;                                                         \
+      link = order < 0 ? &(*link)->left : &(*link)->right;                     \
+    }                                                                          \
+    NAME##_node_t *node = *link;                                               \
+    if (node->left && node->right) {                                           \
+      NAME##_node_t **rightmost = &node->left;                                 \
+      node->size--;                                                            \
+      while ((*rightmost)->right) {                                            \
+        (*rightmost)->size--;                                                  \
+        rightmost = &(*rightmost)->right;                                      \
+      }                                                                        \
+      NAME##_node_t *replacement = *rightmost;                                 \
+      node->key = replacement->key;                                            \
+      node->value = replacement->value;                                        \
+      *rightmost = replacement->left;                                          \
+      node = replacement;                                                      \
+    } else {                                                                   \
+      *link = node->left ? node->left : node->right;                           \
+    }                                                                          \
+    free(node);                                                                \
+  }                                                                            \
+                                                                               \
+  void NAME##_dispose(NAME##_node_t **tree) {                                  \
+    NAME##_node_t *node = *tree;                                               \
+    while (node) {                                                             \
+      if (node->left) {                                                        \
+        NAME##_node_t *left = node->left;                                      \
+        node->left = left->right;                                              \
+        left->right = node;                                                    \
+        node = left;                                                           \
+      } else {                                                                 \
+        NAME##_node_t *right = node->right;                                    \
+        free(node);                                                            \
+        node = right;                                                          \
+      }                                                                        \
+    }                                                                          \
+    *tree = NULL;                                                              \
+  }                                                                            \
+                                                                               \
+  int NAME##_rank(NAME##_node_t *tree, K key) {                                \
+    int rank = 0;                                                              \
+    while (tree) {                                                             \
+      int order = CMP(key, tree->key);                                         \
+      if (order <= 0) {                                                        \
+        tree = tree->left;                                                     \
+      } else {                                                                 \
+        rank += NAME##_size(tree->left) + 1;                                   \
+        tree = tree->right;                                                    \
+      }                                                                        \
+    }                                                                          \
+    return rank;                                                               \
+  }                                                                            \
+                                                                               \
+  NAME##_node_t *NAME##_select(NAME##_node_t *tree, int k) {                   \
+    if (k < 0 || k >= NAME##_size(tree)) {                                     \
+      return NULL;                                                             \
+    }                                                                          \
+    while (k != NAME##_size(tree->left)) {                                     \
+      if (k < NAME##_size(tree->left)) {                                       \
+        tree = tree->left;                                                     \
+      } else {                                                                 \
+        k -= NAME##_size(tree->left) + 1;                                      \
+        tree = tree->right;                                                    \
+      }                                                                        \
+    }                                                                          \
+    return tree;                                                               \
+  }                                                                            \
+                                                                               \
+  void NAME##_for_each(NAME##_node_t *tree,                                    \
+                       void (*visit)(NAME##_node_t *node, void *data),         \
+                       void *data) {                                           \
+    NAME##_node_t *node = tree;                                                \
+    while (node) {                                                             \
+      if (!node->left) {                                                       \
+        visit(node, data);                                                     \
+        node = node->right;                                                    \
+        continue;                                                              \
+      }                                                                        \
+      NAME##_node_t *predecessor = node->left;                                 \
+      while (predecessor->right && predecessor->right != node) {               \
+        predecessor = predecessor->right;                                      \
+      }                                                                        \
+      if (!predecessor->right) {                                               \
+        predecessor->right = node;                                             \
+        node = node->left;                                                     \
+      } else {                                                                 \
+        predecessor->right = NULL;                                             \
+        visit(node, data);                                                     \
+        node = node->right;                                                    \
+      }                                                                        \
+    }                                                                          \
+  }
+
+#endif
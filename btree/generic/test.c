@@ -0,0 +1,143 @@
+#include "generic.h"
+#include "../test_check.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Fixed-size string key
+typedef struct name {
+  char text[16];
+} name_t;
+
+// Composite key ordered by year, then by id
+typedef struct record_key {
+  int year;
+  int id;
+} record_key_t;
+
+static inline int compare_i64(int64_t a, int64_t b) { return (a > b) - (a < b); }
+
+static inline int compare_name(name_t a, name_t b) {
+  return strncmp(a.text, b.text, sizeof(a.text));
+}
+
+static inline int compare_record(record_key_t a, record_key_t b) {
+  if (a.year != b.year) {
+    return a.year < b.year ? -1 : 1;
+  }
+  return (a.id > b.id) - (a.id < b.id);
+}
+
+BSTDEC(int64_t, double, bst_i64)
+BSTDEF(int64_t, double, bst_i64, compare_i64)
+
+BSTDEC(name_t, int, bst_name)
+BSTDEF(name_t, int, bst_name, compare_name)
+
+BSTDEC(record_key_t, const char *, bst_record)
+BSTDEF(record_key_t, const char *, bst_record, compare_record)
+
+// Number of int64 keys inserted by the tests
+#define KEY_COUNT 10000
+
+// Checks that the keys come in increasing order, data holds the previous key and the count
+typedef struct order_check {
+  int64_t previous;
+  int count;
+  bool sorted;
+} order_check_t;
+
+void check_order(bst_i64_node_t *node, void *data) {
+  order_check_t *order = data;
+  if (order->count > 0 && node->key <= order->previous) {
+    order->sorted = false;
+  }
+  order->previous = node->key;
+  order->count++;
+}
+
+void print_record(bst_record_node_t *node, void *data) {
+  printf("[%d/%d,%s]", node->key.year, node->key.id, node->value);
+}
+
+name_t make_name(const char *text) {
+  name_t name = {{0}};
+  strncpy(name.text, text, sizeof(name.text) - 1);
+  return name;
+}
+
+int main(int argc, char *argv[]) {
+  printf("Generic Binary Search Tree - testing script\n");
+  printf("-------------------------------------------\n\n");
+
+  printf("[test_i64_insert_many] Insert %d int64 keys, delete every third\n",
+         KEY_COUNT);
+  bst_i64_node_t *numbers;
+  bst_i64_init(&numbers);
+  uint64_t state = 88172645463325252ull;
+  int64_t keys[KEY_COUNT];
+  for (int i = 0; i < KEY_COUNT; i++) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    keys[i] = (int64_t)state;
+    bst_i64_insert(&numbers, keys[i], i * 0.5);
+  }
+  for (int i = 0; i < KEY_COUNT; i += 3) {
+    bst_i64_delete(&numbers, keys[i]);
+  }
+  bool found = true;
+  for (int i = 0; i < KEY_COUNT; i++) {
+    double value;
+    bool present = bst_i64_search(numbers, keys[i], &value);
+    if (present != (i % 3 != 0) || (present && value != i * 0.5)) {
+      found = false;
+    }
+  }
+  order_check_t order = {0, 0, true};
+  bst_i64_for_each(numbers, check_order, &order);
+  int remaining = KEY_COUNT - (KEY_COUNT + 2) / 3;
+  check(found && order.sorted && order.count == remaining &&
+            bst_i64_size(numbers) == remaining,
+        "Remaining keys were found in increasing order");
+
+  printf("[test_i64_order_statistics] Select the median and rank it back\n");
+  bst_i64_node_t *median = bst_i64_select(numbers, remaining / 2);
+  check(median != NULL && bst_i64_rank(numbers, median->key) == remaining / 2 &&
+            bst_i64_select(numbers, remaining) == NULL,
+        "Rank of the median is its position");
+  bst_i64_dispose(&numbers);
+
+  printf("[test_name_keys] Insert and update fixed-size string keys\n");
+  bst_name_node_t *names;
+  bst_name_init(&names);
+  const char *texts[] = {"hedgehog", "ant", "zebra", "mole", "ant", "badger"};
+  for (int i = 0; i < 6; i++) {
+    bst_name_insert(&names, make_name(texts[i]), i);
+  }
+  int value;
+  check(bst_name_size(names) == 5 &&
+            bst_name_search(names, make_name("ant"), &value) && value == 4 &&
+            !bst_name_search(names, make_name("antelope"), &value) &&
+            bst_name_rank(names, make_name("mole")) == 3,
+        "Duplicate key was updated and the keys are ordered");
+  bst_name_dispose(&names);
+
+  printf("[test_composite_keys] Order composite keys by year and id\n");
+  bst_record_node_t *records;
+  bst_record_init(&records);
+  bst_record_insert(&records, (record_key_t){2024, 7}, "g");
+  bst_record_insert(&records, (record_key_t){2023, 9}, "i");
+  bst_record_insert(&records, (record_key_t){2024, 1}, "a");
+  bst_record_insert(&records, (record_key_t){2023, 10}, "j");
+  bst_record_for_each(records, print_record, NULL);
+  printf("\n");
+  bst_record_node_t *first = bst_record_select(records, 0);
+  bst_record_node_t *last = bst_record_select(records, 3);
+  check(first && first->key.year == 2023 && first->key.id == 9 && last &&
+            last->key.year == 2024 && last->key.id == 7,
+        "Keys are ordered by year and id");
+  bst_record_dispose(&records);
+
+  return tests_summary();
+}
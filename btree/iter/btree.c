@@ -64,67 +64,54 @@ bool bst_search(bst_node_t *tree, char key, int *value) {
  * uzlu obsahuje jenom menší klíče, pravý větší. 
  *
  * Funkci implementujte iterativně bez použití vlastních pomocných funkcí.
+ * Je-li nastaven parametr bst_alpha, příliš hluboko vložený uzel vyvolá
+ * přestavění podstromu funkcí bst_scapegoat.
  */
 void bst_insert(bst_node_t **tree, char key, int value) {
-  bst_node_t *node = malloc(sizeof(bst_node_t));  // we allocate memory for node
-  
-  if(!node) return;                               // allotion check                                        
-  
-  node->key = key;                                // we set key and value
-  node->value = value;                            
-  node->left = NULL;                              // nodes init
-  node->right = NULL;                             
+  bst_node_t **link = tree;                       // we start with the root link
+  int depth = 0;                                  // depth of the node under link
 
-  if(!*tree)                                      // if tree is empty
+  while(*link)                                    // while link points to a node
   {
-    *tree = node;                                 // we root to node
-    return;
-  }
+    bst_node_t *current = *link;
 
-  else                                            // if tree is not empty
-  {
-    bst_node_t *current = *tree;                  // we create current node and set it to tree
+    if(key == current->key)
+    {
+      current->value = value;                     // if key is equal to current->key, we replace value
+      return;
+    }
 
-    while(current)                                // while current contains nodes
+    else if(key < current->key)                   // if key is less than current->key
     {
-      if(key == current->key)
-      {
-        current->value = value;                   // if key is equal to current->key, we replace value
-        free(node);                               // we free node
-        return;
-      }
-      
-      else if(key < current->key)                 // if key is less than current->key
-      {
-        
-        if(current->left)                         // if left subtree of current is empty
-        {
-          current = current->left;                // we set left subtree of current to node
-        }
-        
-        else                                      // if left subtree of current is not empty
-        {
-          current->left = node;                   // we go to left subtree
-          return;
-        }
-      }
-      
-      else if(key > current->key)                 // if key is greater than current->key
-      {
-        
-        if(current->right)                        // if right subtree of current is empty
-        {
-          current = current->right;               // we set right subtree of current to node
-        }
-        
-        else                                      // if right subtree of current is not empty
-        {
-          current->right = node;                  // we go to right subtree
-          return;
-        }
-      }
+      link = &current->left;                      // we go to left subtree
+    }
+
+    else                                          // if key is greater than current->key
+    {
+      link = &current->right;                     // we go to right subtree
     }
+
+    depth++;
+  }
+
+  bst_node_t *node = bst_node_alloc();            // we allocate memory for node only when it is really inserted
+
+  if(!node) return;                               // allocation check
+
+  node->key = key;                                // we set key and value
+  node->value = value;
+  node->size = 1;
+  node->left = NULL;                              // nodes init
+  node->right = NULL;
+
+  *link = node;                                   // we link the node to the found empty subtree
+
+  for(bst_node_t *current = *tree; current != node; current = key < current->key ? current->left : current->right)
+  {
+    current->size++;                              // every node on the path gained one descendant
   }
+
+  bst_scapegoat(tree, key, depth);                // rebuilds a subtree if the node is too deep
 }
 
 /*
@@ -148,35 +135,24 @@ void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree) {
   
   while(current->right){
     parent = current;                 // we set parent to current
+    current->size--;                  // rightmost node will be removed from this subtree
     current = current->right;         // we go to right subtree
   }
 
-  if(current->left)
+  target->key = current->key;         // we replace key and value of target with key and value of rightmost node
+  target->value = current->value;
+
+  if(current == *tree)
   {
-    target->key = current->key;       // we replace key and value of target with key and value of rightmost node
-    target->value = current->value;
-    
-    parent->right = current->left;    // we set parent->right to current->left
-    free(current);                    // we free current
+    *tree = current->left;            // if rightmost node is the subtree root, its left subtree takes its place
   }
-  
+
   else
   {
-    target->key = current->key;       // we replace key and value of target with key and value of rightmost node
-    target->value = current->value;
-    
-    if(target!=parent)                // if target is not parent
-    {
-      parent->right = NULL;           // we set parent->right to NULL
-    }
-    
-    else 
-    {
-      parent->left = NULL;            // we set parent->left to NULL
-    }
-    
-    free(current);                    // we free current
+    parent->right = current->left;    // else we set parent->right to current->left
   }
+
+  bst_node_free(current);             // we free current
 }
 
 /*
@@ -196,7 +172,8 @@ void bst_delete(bst_node_t **tree, char key) {
   bst_node_t *current = *tree;                        
   bst_node_t *parent = NULL;      
   
-  if(!current) return;                                      // if tree is empty, we return
+  int value;
+  if(!bst_search(current, key, &value)) return;             // if key is not in the tree, we return and sizes stay untouched
   
   while(current)                                            // while current contains nodes
   {
@@ -204,13 +181,16 @@ void bst_delete(bst_node_t **tree, char key) {
     {
       if(current->left && current->right)
       {
+        current->size--;                                    // current loses the rightmost node of its left subtree
         bst_replace_by_rightmost(current, &current->left);  // if current has both subtrees, we replace it with rightmost node in left subtree
+        break;
       }
       else if(!current->left && !current->right)
       {
         if(current == *tree)
         {
-          free(current);                                    // if current is root and has no subtrees, we free current
+          bst_node_free(current);                           // if current is root and has no subtrees, we free current
+          *tree = NULL;                                     // and the tree becomes empty
           return;
         }
         if(current == parent->left)
@@ -221,7 +201,7 @@ void bst_delete(bst_node_t **tree, char key) {
         {
           parent->right = NULL;                             // if current is right child of parent, we set parent->right to NULL
         }
-        free(current);
+        bst_node_free(current);
         break;
       }
       else
@@ -259,7 +239,7 @@ void bst_delete(bst_node_t **tree, char key) {
             parent->right = current->right;                 // if current is right child of parent and has only right subtree, we set parent->right to right subtree
           }
         }
-        free(current);
+        bst_node_free(current);
         break;
       }
     }
@@ -268,6 +248,7 @@ void bst_delete(bst_node_t **tree, char key) {
       if(current->left)
       {
         parent = current;                                   // we set parent to current
+        current->size--;                                    // deleted node is below current
         current = current->left;                            // we go to left subtree
       }
       else
@@ -280,6 +261,7 @@ void bst_delete(bst_node_t **tree, char key) {
       if(current->right)
       {
         parent = current;                                   // we set parent to current
+        current->size--;                                    // deleted node is below current
         current = current->right;                           // we go to right subtree
       }
       else
@@ -314,7 +296,7 @@ void bst_dispose(bst_node_t **tree) {
     stack_bst_push(&stack, current->left);        // we push left and right subtree of current to stack
     stack_bst_push(&stack, current->right);       
 
-    free(current);
+    bst_node_free(current);
   }
   
   *tree = NULL;
@@ -463,3 +445,69 @@ void bst_postorder(bst_node_t *tree, bst_items_t *items) {
     }
   }
 }
+
+/*
+ * Pomocná funkce pro iterativní průchod rozsahem.
+ *
+ * Prochází po levé větvi k nejlevějšímu uzlu podstromu s klíčem alespoň lo
+ * a ukládá uzly do zásobníku uzlů. Uzly s menším klíčem přeskočí spolu
+ * s jejich levým podstromem. Zásobník má jen MAXSTACK položek, plný
+ * zásobník se proto vyprázdní a zapomenuté uzly s většími klíči najde
+ * funkce bst_range znovu od kořene.
+ *
+ * Funkci implementujte iterativně s pomocí zásobníku a bez použití
+ * vlastních pomocných funkcí.
+ */
+void bst_leftmost_range(bst_node_t *tree, char lo, stack_bst_t *to_visit) {
+  bst_node_t *current = tree;
+
+  while(current)                                    // while current contains nodes
+  {
+    if(current->key < lo)
+    {
+      current = current->right;                     // node and its left subtree are below the range
+    }
+    else
+    {
+      if(to_visit->top == MAXSTACK - 1) stack_bst_init(to_visit); // full stack forgets the ancestors instead of the leftmost nodes
+      stack_bst_push(to_visit, current);            // we push current to stack
+      current = current->left;                      // we go to left subtree
+    }
+  }
+}
+
+/*
+ * Průchod rozsahem klíčů <lo, hi>.
+ *
+ * Pro každý uzel s klíčem z rozsahu zavolá funkci visit, a to ve
+ * vzestupném pořadí klíčů. Do podstromů, které nemohou obsahovat klíč
+ * z rozsahu, funkce nesestupuje. Dojde-li zásobník dříve, než jsou
+ * navštíveny všechny klíče, mohl zapomenout předky, a průchod proto
+ * pokračuje od kořene nejmenším klíčem větším než poslední navštívený.
+ * Strom s hlubší levou hranou než MAXSTACK se tak projde celý.
+ *
+ * Funkci implementujte iterativně pomocí funkce bst_leftmost_range a
+ * zásobníku uzlů a bez použití vlastních pomocných funkcí.
+ */
+void bst_range(bst_node_t *tree, char lo, char hi, bst_visitor_t visit, void *data) {
+  stack_bst_t stack;
+  stack_bst_init(&stack);                                 // we initialize stack
+
+  bst_leftmost_range(tree, lo, &stack);                   // going to the smallest key not below lo
+
+  while(!stack_bst_empty(&stack))                         // until stack is empty
+  {
+    bst_node_t *current = stack_bst_pop(&stack);          // assigning top of stack to current
+
+    if(current->key > hi) return;                         // keys come in ascending order, so the range is over
+
+    visit(current, data);                                 // we visit current
+    if(current->key == hi) return;                        // no greater key is in the range
+
+    bst_leftmost_range(current->right, lo, &stack);       // we go to most left in right subtree
+    if(stack_bst_empty(&stack))
+    {
+      bst_leftmost_range(tree, current->key + 1, &stack); // ancestors forgotten by a full stack are found again from the root
+    }
+  }
+}
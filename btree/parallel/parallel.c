@@ -0,0 +1,327 @@
+/*
+ * Paralelní průchod stromem s vyvažováním práce krádeží úloh.
+ *
+ * Strom se nejprve rozdělí na kusy v pořadí inorder: podstromy s nejvýše
+ * BST_PARALLEL_GRAIN uzly a jednotlivé uzly nad nimi. Díky velikostem
+ * podstromů je pořadí prvního uzlu každého kusu známé předem. Kusy se
+ * rozdělí na souvislé úseky mezi vlákna, každé vlákno zpracovává svůj
+ * úsek od konce a vlákno, kterému práce došla, krade kusy ze začátku úseků
+ * ostatních vláken.
+ *
+ * Výsledek kusu se ukládá na jeho pozici, redukce proto spojuje dílčí
+ * výsledky v pořadí klíčů a paralelní inorder zapisuje každý uzel přímo
+ * na jeho konečné místo v poli.
+ */
+
+#include "parallel.h"
+#include <stdlib.h>
+#include <threads.h>
+
+// Part of the tree processed at once, either the whole subtree or only its root
+typedef struct bst_piece {
+  bst_node_t *node;
+  bool whole;
+  int rank;                                       // inorder position of the first node of the piece
+} bst_piece_t;
+
+// Range of pieces owned by one worker, the owner takes from the bottom and thieves from the top
+typedef struct bst_queue {
+  mtx_t lock;
+  int top;
+  int bottom;
+} bst_queue_t;
+
+// Kind of the work done on every piece
+typedef enum bst_job_kind { JOB_FOR_EACH, JOB_REDUCE, JOB_INORDER } bst_job_kind_t;
+
+// Work shared by all workers of one call
+typedef struct bst_job {
+  bst_job_kind_t kind;
+  bst_piece_t *pieces;
+  int count;
+  bst_queue_t *queues;
+  int threads;
+  bst_visitor_t visit;
+  bst_map_t map;
+  bst_combine_t combine;
+  long long identity;
+  void *data;
+  long long *partials;                            // reduce result of every piece
+  bst_node_t **nodes;                             // inorder output
+} bst_job_t;
+
+// Argument of one worker thread
+typedef struct bst_worker {
+  bst_job_t *job;
+  int id;
+} bst_worker_t;
+
+// Function to split the subtree into pieces in inorder, rank is the position of its leftmost node
+void collectPieces(bst_job_t *job, bst_node_t *node, int rank)
+{
+  if(!node) return;
+
+  if(node->size <= BST_PARALLEL_GRAIN)            // small enough to be processed by one thread
+  {
+    job->pieces[job->count++] = (bst_piece_t){node, true, rank};
+    return;
+  }
+
+  int left_size = bst_size(node->left);
+  collectPieces(job, node->left, rank);
+  job->pieces[job->count++] = (bst_piece_t){node, false, rank + left_size};
+  collectPieces(job, node->right, rank + left_size + 1);
+}
+
+// Function to process the node, acc is the reduce accumulator and rank the inorder position of the node
+void processNode(bst_job_t *job, bst_node_t *node, long long *acc, int rank)
+{
+  switch(job->kind)
+  {
+    case JOB_FOR_EACH:
+      job->visit(node, job->data);
+      break;
+    case JOB_REDUCE:
+      *acc = job->combine(*acc, job->map(node, job->data));
+      break;
+    case JOB_INORDER:
+      job->nodes[rank] = node;
+      break;
+  }
+}
+
+// Function to process the whole subtree sequentially in inorder, returns the rank after its last node
+int processSubtree(bst_job_t *job, bst_node_t *node, long long *acc, int rank)
+{
+  if(!node) return rank;
+
+  rank = processSubtree(job, node->left, acc, rank);
+  processNode(job, node, acc, rank);
+  return processSubtree(job, node->right, acc, rank + 1);
+}
+
+// Function to process the piece with index and store its reduce result
+void processPiece(bst_job_t *job, int index)
+{
+  bst_piece_t *piece = &job->pieces[index];
+  long long acc = job->identity;
+
+  if(piece->whole)
+  {
+    processSubtree(job, piece->node, &acc, piece->rank);
+  }
+  else
+  {
+    processNode(job, piece->node, &acc, piece->rank);
+  }
+
+  if(job->partials)
+  {
+    job->partials[index] = acc;
+  }
+}
+
+// Function to take a piece from the worker's own range, or steal one from another range, returns -1 when all work is taken
+int takePiece(bst_job_t *job, int id)
+{
+  bst_queue_t *own = &job->queues[id];
+  int index = -1;
+
+  mtx_lock(&own->lock);
+  if(own->top < own->bottom)
+  {
+    index = --own->bottom;
+  }
+  mtx_unlock(&own->lock);
+
+  for(int i = 1; index < 0 && i < job->threads; i++)
+  {
+    bst_queue_t *victim = &job->queues[(id + i) % job->threads];
+
+    mtx_lock(&victim->lock);
+    if(victim->top < victim->bottom)
+    {
+      index = victim->top++;                      // thief takes the end the owner works away from
+    }
+    mtx_unlock(&victim->lock);
+  }
+
+  return index;                                   // no piece is created later, so empty queues mean the end
+}
+
+// Function run by every worker, including the calling thread
+int runWorker(void *arg)
+{
+  bst_worker_t *worker = arg;
+  int index;
+
+  while((index = takePiece(worker->job, worker->id)) >= 0)
+  {
+    processPiece(worker->job, index);
+  }
+
+  return 0;
+}
+
+// Function to split the tree into pieces and process them with the given number of threads, returns false if allocation or lock initialization fails
+bool runJob(bst_job_t *job, bst_node_t *tree, int threads)
+{
+  int size = bst_size(tree);
+  if(threads < 1) threads = 1;
+  if(threads > size) threads = size > 0 ? size : 1;
+
+  job->pieces = malloc(sizeof(bst_piece_t) * (size + 1));
+  job->queues = malloc(sizeof(bst_queue_t) * threads);
+  bst_worker_t *workers = malloc(sizeof(bst_worker_t) * threads);
+  thrd_t *handles = malloc(sizeof(thrd_t) * threads);
+  bool *started = calloc(threads, sizeof(bool));
+
+  bool ok = job->pieces && job->queues && workers && handles && started;
+  if(ok)
+  {
+    job->count = 0;
+    collectPieces(job, tree, 0);
+
+    if(job->kind == JOB_REDUCE)
+    {
+      job->partials = malloc(sizeof(long long) * (job->count + 1));
+      ok = job->partials != NULL;
+    }
+  }
+
+  int locks = 0;                                  // number of initialized queue locks
+  while(ok && locks < threads)
+  {
+    ok = mtx_init(&job->queues[locks].lock, mtx_plain) == thrd_success;
+    if(ok) locks++;
+  }
+
+  if(!ok)                                         // locks initialized before the failure are destroyed
+  {
+    for(int i = 0; i < locks; i++)
+    {
+      mtx_destroy(&job->queues[i].lock);
+    }
+  }
+
+  if(ok)
+  {
+    job->threads = threads;
+    for(int i = 0; i < threads; i++)              // every worker owns a contiguous range of pieces
+    {
+      job->queues[i].top = (int)((long long)job->count * i / threads);
+      job->queues[i].bottom = (int)((long long)job->count * (i + 1) / threads);
+      workers[i] = (bst_worker_t){job, i};
+    }
+
+    for(int i = 1; i < threads; i++)              // if a thread is not started, its range gets stolen
+    {
+      started[i] = thrd_create(&handles[i], runWorker, &workers[i]) == thrd_success;
+    }
+
+    runWorker(&workers[0]);                       // calling thread works too
+
+    for(int i = 1; i < threads; i++)
+    {
+      if(started[i])
+      {
+        thrd_join(handles[i], NULL);
+      }
+    }
+
+    for(int i = 0; i < threads; i++)
+    {
+      mtx_destroy(&job->queues[i].lock);
+    }
+  }
+
+  free(job->pieces);
+  free(job->queues);
+  free(workers);
+  free(handles);
+  free(started);
+  return ok;
+}
+
+/*
+ * Paralelní návštěva všech uzlů stromu.
+ *
+ * Funkce visit se zavolá pro každý uzel právě jednou, souběžně z až
+ * threads vláken a v libovolném pořadí. Uzly podstromu zpracovávaného
+ * jedním vláknem se navštíví v pořadí inorder. Funkce visit nesmí měnit
+ * strukturu stromu. Při nedostatku paměti se žádný uzel nenavštíví.
+ */
+void bst_parallel_for_each(bst_node_t *tree, bst_visitor_t visit, void *data, int threads) {
+  bst_job_t job = {0};
+  job.kind = JOB_FOR_EACH;
+  job.visit = visit;
+  job.data = data;
+
+  runJob(&job, tree, threads);
+}
+
+/*
+ * Paralelní redukce hodnot uzlů stromu.
+ *
+ * Vrací combine(...combine(combine(identity, map(u1)), map(u2))..., map(un))
+ * pro uzly u1 až un v pořadí klíčů, funkce combine proto musí být
+ * asociativní, ale nemusí být komutativní, a identity musí být jejím
+ * neutrálním prvkem. Funkce map se volá souběžně z více vláken. Při
+ * nedostatku paměti se výsledek spočítá v jednom vlákně.
+ */
+long long bst_parallel_reduce(bst_node_t *tree, bst_map_t map, bst_combine_t combine,
+                              long long identity, void *data, int threads) {
+  bst_job_t job = {0};
+  job.kind = JOB_REDUCE;
+  job.map = map;
+  job.combine = combine;
+  job.identity = identity;
+  job.data = data;
+
+  long long result = identity;
+
+  if(runJob(&job, tree, threads))
+  {
+    for(int i = 0; i < job.count; i++)            // partial results are combined in key order
+    {
+      result = combine(result, job.partials[i]);
+    }
+  }
+  else
+  {
+    processSubtree(&job, tree, &result, 0);       // sequential fallback
+  }
+
+  free(job.partials);
+  return result;
+}
+
+/*
+ * Paralelní průchod inorder.
+ *
+ * Uzly se přidají na konec pole items ve stejném pořadí jako u funkce
+ * bst_inorder. Pole se zvětší předem podle velikosti stromu a každé vlákno
+ * zapisuje uzly přímo na jejich výsledné pozice. Při nedostatku paměti
+ * zůstane pole beze změny.
+ */
+void bst_parallel_inorder(bst_node_t *tree, bst_items_t *items, int threads) {
+  int size = bst_size(tree);
+
+  if(items->capacity < items->size + size)
+  {
+    bst_node_t **nodes = realloc(items->nodes, sizeof(bst_node_t *) * (items->size + size));
+    if(!nodes) return;
+
+    items->nodes = nodes;
+    items->capacity = items->size + size;
+  }
+
+  bst_job_t job = {0};
+  job.kind = JOB_INORDER;
+  job.nodes = items->nodes + items->size;
+
+  if(runJob(&job, tree, threads))
+  {
+    items->size += size;
+  }
+}
@@ -0,0 +1,26 @@
+/*
+ * Hlavičkový soubor pro paralelní průchod binárním vyhledávacím stromem.
+ */
+
+#ifndef IAL_BTREE_PARALLEL_H
+#define IAL_BTREE_PARALLEL_H
+
+#include "../btree.h"
+
+// Největší podstrom, který zpracuje jedno vlákno jako celek
+#ifndef BST_PARALLEL_GRAIN
+#define BST_PARALLEL_GRAIN 16
+#endif
+
+// Funkce vracející příspěvek uzlu k výsledku redukce
+typedef long long (*bst_map_t)(bst_node_t *node, void *data);
+
+// Asociativní funkce spojující dva dílčí výsledky, a předchází b v pořadí klíčů
+typedef long long (*bst_combine_t)(long long a, long long b);
+
+void bst_parallel_for_each(bst_node_t *tree, bst_visitor_t visit, void *data, int threads);
+long long bst_parallel_reduce(bst_node_t *tree, bst_map_t map, bst_combine_t combine,
+                              long long identity, void *data, int threads);
+void bst_parallel_inorder(bst_node_t *tree, bst_items_t *items, int threads);
+
+#endif
@@ -0,0 +1,73 @@
+#include "parallel.h"
+#include "../test_check.h"
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Number of threads used by the tests
+#define THREADS 4
+
+// Inserts all 256 keys in a scattered order, the value is the key
+void insert_all(bst_node_t **tree) {
+  for (int i = 0; i < 256; i++) {
+    char key = (char)((i * 37) % 256 - 128);
+    bst_insert(tree, key, key);
+  }
+}
+
+void count_visitor(bst_node_t *node, void *data) {
+  atomic_fetch_add((atomic_int *)data, 1);
+}
+
+long long value_map(bst_node_t *node, void *data) { return node->value; }
+
+long long sum_combine(long long a, long long b) { return a + b; }
+
+// Associative but not commutative, the result is the last mapped value in key order
+long long last_combine(long long a, long long b) { return b == LLONG_MIN ? a : b; }
+
+int main(int argc, char *argv[]) {
+  printf("Parallel Binary Search Tree Traversal - testing script\n");
+  printf("------------------------------------------------------\n\n");
+
+  bst_node_t *tree;
+  bst_init(&tree);
+  insert_all(&tree);
+
+  printf("[test_parallel_for_each] Visit all 256 nodes from %d threads\n",
+         THREADS);
+  atomic_int visited;
+  atomic_init(&visited, 0);
+  bst_parallel_for_each(tree, count_visitor, &visited, THREADS);
+  check(atomic_load(&visited) == 256, "Every node was visited once");
+
+  printf("[test_parallel_reduce] Sum the values and find the last one\n");
+  long long sum = bst_parallel_reduce(tree, value_map, sum_combine, 0, NULL,
+                                      THREADS);
+  long long last = bst_parallel_reduce(tree, value_map, last_combine,
+                                       LLONG_MIN, NULL, THREADS);
+  check(sum == -128 && last == 127,
+        "Sum is -128 and the value of the greatest key is last");
+
+  printf("[test_parallel_inorder] Traverse the tree using parallel inorder\n");
+  bst_items_t sequential = {NULL, 0, 0};
+  bst_items_t parallel = {NULL, 0, 0};
+  bst_inorder(tree, &sequential);
+  bst_add_node_to_items(tree, &parallel);
+  bst_parallel_inorder(tree, &parallel, THREADS);
+  bool same = parallel.size == sequential.size + 1 && parallel.nodes[0] == tree;
+  for (int i = 0; same && i < sequential.size; i++) {
+    same = parallel.nodes[i + 1] == sequential.nodes[i];
+  }
+  free(sequential.nodes);
+  free(parallel.nodes);
+  check(same, "Nodes were appended in the same order as by bst_inorder");
+
+  printf("[test_parallel_empty] Reduce an empty tree\n");
+  bst_dispose(&tree);
+  check(bst_parallel_reduce(tree, value_map, sum_combine, 7, NULL, THREADS) == 7,
+        "Result is the identity");
+
+  return tests_summary();
+}
@@ -0,0 +1,338 @@
+/*
+ * Perzistentní binární vyhledávací strom s kopírováním cesty.
+ *
+ * Vložení ani odstranění nemění existující uzly. Zkopíruje se pouze cesta od
+ * kořene ke změněnému uzlu a nová verze sdílí všechny ostatní podstromy
+ * s verzí původní. Každá verze je tak neměnný strom, který lze číst
+ * obyčejnými funkcemi bst_search, bst_inorder, bst_range či bst_rank bez
+ * jakéhokoli zamykání, i když mezitím vznikají verze nové.
+ *
+ * Uzly jsou uvolňovány počítáním odkazů. Odkaz drží každý rodič a každý
+ * kořen verze, který vlastní zapisovatel nebo čtenář. Uzel se uvolní, když
+ * zanikne poslední verze, která jej obsahuje.
+ */
+
+#include "persist.h"
+#include <stdlib.h>
+
+// Function to get the persistent node of a tree node
+bst_pnode_t *pnodeOf(bst_node_t *node)
+{
+  return (bst_pnode_t *)node;                     // node is the first member, so the addresses are equal
+}
+
+// Function to allocate a node with one reference, children are taken over without retaining them
+bst_node_t *newNode(char key, int value, bst_node_t *left, bst_node_t *right)
+{
+  bst_pnode_t *pnode = malloc(sizeof(bst_pnode_t));
+  if(!pnode) return NULL;
+
+  pnode->node.key = key;
+  pnode->node.value = value;
+  pnode->node.left = left;
+  pnode->node.right = right;
+  pnode->node.size = 1 + bst_size(left) + bst_size(right);
+  atomic_init(&pnode->refs, 1);
+
+  return &pnode->node;
+}
+
+// Function to copy the node with new children, the children passed in are owned by the copy, the old ones are retained
+bst_node_t *copyNode(bst_node_t *node, bst_node_t *left, bst_node_t *right, bool left_new)
+{
+  bst_node_t *shared = left_new ? node->right : node->left;
+  bst_persist_retain(shared);                     // untouched subtree gains a parent in the new version
+
+  bst_node_t *copy = newNode(node->key, node->value, left, right);
+  if(!copy)
+  {
+    bst_persist_release(shared);
+    bst_persist_release(left_new ? left : right);
+  }
+
+  return copy;
+}
+
+/*
+ * Zvýšení počtu odkazů na verzi stromu.
+ *
+ * Volá ten, kdo si chce ponechat kořen verze, který sám nevytvořil.
+ */
+void bst_persist_retain(bst_node_t *root) {
+  if(root)
+  {
+    atomic_fetch_add_explicit(&pnodeOf(root)->refs, 1, memory_order_relaxed);
+  }
+}
+
+/*
+ * Uvolnění verze stromu.
+ *
+ * Sníží počet odkazů na kořen. Uzly, na které poté nevede žádný odkaz, se
+ * uvolní spolu s odkazy na jejich potomky. Uzly sdílené s jinou verzí
+ * zůstanou zachovány.
+ */
+void bst_persist_release(bst_node_t *root) {
+  if(!root) return;
+
+  if(atomic_fetch_sub_explicit(&pnodeOf(root)->refs, 1, memory_order_acq_rel) == 1)
+  {
+    bst_persist_release(root->left);              // last reference is gone, the node gives up its children
+    bst_persist_release(root->right);
+    free(pnodeOf(root));
+  }
+}
+
+/*
+ * Vložení uzlu do nové verze stromu.
+ *
+ * Vrací kořen nové verze, ve které má klíč key hodnotu value. Verze root
+ * zůstává beze změny a volající dále vlastní její odkaz, nová verze se
+ * vrací s jedním odkazem. Při nedostatku paměti vrací NULL.
+ */
+bst_node_t *bst_persist_insert(bst_node_t *root, char key, int value) {
+  if(!root)
+  {
+    return newNode(key, value, NULL, NULL);       // new leaf
+  }
+
+  if(key == root->key)                            // we copy the node with the new value and share both subtrees
+  {
+    bst_persist_retain(root->left);
+    bst_persist_retain(root->right);
+    bst_node_t *copy = newNode(key, value, root->left, root->right);
+    if(!copy)
+    {
+      bst_persist_release(root->left);
+      bst_persist_release(root->right);
+    }
+    return copy;
+  }
+
+  if(key < root->key)
+  {
+    bst_node_t *left = bst_persist_insert(root->left, key, value);
+    if(!left) return NULL;
+    return copyNode(root, left, root->right, true);
+  }
+  else
+  {
+    bst_node_t *right = bst_persist_insert(root->right, key, value);
+    if(!right) return NULL;
+    return copyNode(root, root->left, right, false);
+  }
+}
+
+// Function to copy the subtree without its rightmost node, the removed node is stored to rightmost
+bst_node_t *copyWithoutRightmost(bst_node_t *tree, bst_node_t **rightmost, bool *failed)
+{
+  if(!tree->right)
+  {
+    *rightmost = tree;
+    bst_persist_retain(tree->left);               // left subtree takes the place of the rightmost node
+    return tree->left;
+  }
+
+  bst_node_t *right = copyWithoutRightmost(tree->right, rightmost, failed);
+  if(*failed)
+  {
+    return NULL;
+  }
+
+  bst_node_t *copy = copyNode(tree, tree->left, right, false);
+  if(!copy)
+  {
+    *failed = true;
+  }
+
+  return copy;
+}
+
+/*
+ * Odstranění uzlu v nové verzi stromu.
+ *
+ * Vrací kořen nové verze bez klíče key. Pokud klíč ve stromu není, vrací
+ * se stejný kořen s odkazem navíc, volající tedy vždy vlastní jeden odkaz
+ * na výsledek. Verze root zůstává beze změny. Při nedostatku paměti vrací
+ * kořen root s odkazem navíc, tedy verzi beze změny.
+ */
+bst_node_t *bst_persist_delete(bst_node_t *root, char key) {
+  bst_node_t *result = root;
+
+  if(!root)
+  {
+    return NULL;
+  }
+
+  if(key == root->key)
+  {
+    if(!root->left || !root->right)               // the only child takes the place of the node
+    {
+      result = root->left ? root->left : root->right;
+      bst_persist_retain(result);
+      return result;
+    }
+
+    bst_node_t *rightmost;                        // node is replaced by the greatest key of its left subtree
+    bool failed = false;
+    bst_node_t *left = copyWithoutRightmost(root->left, &rightmost, &failed);
+    if(!failed)
+    {
+      bst_persist_retain(root->right);
+      result = newNode(rightmost->key, rightmost->value, left, root->right);
+      if(result) return result;
+
+      bst_persist_release(left);
+      bst_persist_release(root->right);
+    }
+  }
+  else if(key < root->key && root->left)
+  {
+    bst_node_t *left = bst_persist_delete(root->left, key);
+    if(left != root->left)                        // key was removed from the left subtree
+    {
+      result = copyNode(root, left, root->right, true);
+      if(result) return result;
+    }
+    else
+    {
+      bst_persist_release(left);
+    }
+  }
+  else if(key > root->key && root->right)
+  {
+    bst_node_t *right = bst_persist_delete(root->right, key);
+    if(right != root->right)                      // key was removed from the right subtree
+    {
+      result = copyNode(root, root->left, right, false);
+      if(result) return result;
+    }
+    else
+    {
+      bst_persist_release(right);
+    }
+  }
+
+  bst_persist_retain(root);                       // nothing changed, the caller gets the same version
+  return root;
+}
+
+/*
+ * Inicializace sdíleného stromu.
+ *
+ * Při chybě inicializace zámku vrací false.
+ */
+bool bst_shared_init(bst_shared_t *shared) {
+  atomic_init(&shared->root, NULL);
+  for(int i = 0; i < BST_SHARED_HAZARDS; i++)
+  {
+    atomic_init(&shared->hazards[i], NULL);
+  }
+
+  return mtx_init(&shared->write_lock, mtx_plain) == thrd_success;
+}
+
+// Function to replace the current version by the new one and release the old one once no reader is taking it
+void publish(bst_shared_t *shared, bst_node_t *root)
+{
+  bst_node_t *old = atomic_exchange(&shared->root, root);   // readers taking a snapshot from now on see the new version
+
+  for(int i = 0; old && i < BST_SHARED_HAZARDS; i++)
+  {
+    while(atomic_load(&shared->hazards[i]) == old)          // the reader may not have retained the old version yet
+    {
+      thrd_yield();
+    }
+  }
+
+  bst_persist_release(old);                       // readers still holding the old version keep their references
+}
+
+/*
+ * Vložení uzlu do sdíleného stromu.
+ *
+ * Nová verze se sestaví bez omezení čtenářů a zveřejní se jedinou atomickou
+ * záměnou kořene. Při nedostatku paměti zůstane aktuální verze beze změny.
+ */
+void bst_shared_insert(bst_shared_t *shared, char key, int value) {
+  mtx_lock(&shared->write_lock);
+
+  bst_node_t *root = bst_persist_insert(atomic_load(&shared->root), key, value);
+  if(root)
+  {
+    publish(shared, root);
+  }
+
+  mtx_unlock(&shared->write_lock);
+}
+
+/*
+ * Odstranění uzlu ze sdíleného stromu.
+ */
+void bst_shared_delete(bst_shared_t *shared, char key) {
+  mtx_lock(&shared->write_lock);
+
+  bst_node_t *current = atomic_load(&shared->root);
+  bst_node_t *root = bst_persist_delete(current, key);
+  if(root != current)
+  {
+    publish(shared, root);
+  }
+  else
+  {
+    bst_persist_release(root);                    // nothing was removed, we drop the extra reference
+  }
+
+  mtx_unlock(&shared->write_lock);
+}
+
+// Function to find a free hazard slot and store root into it
+_Atomic(bst_node_t *) *claimHazard(bst_shared_t *shared, bst_node_t *root)
+{
+  for(int i = 0; ; i = (i + 1) % BST_SHARED_HAZARDS)        // all slots are busy only with more readers than slots
+  {
+    bst_node_t *expected = NULL;
+    if(atomic_compare_exchange_weak(&shared->hazards[i], &expected, root))
+    {
+      return &shared->hazards[i];
+    }
+  }
+}
+
+/*
+ * Získání konzistentní verze sdíleného stromu.
+ *
+ * Vrací kořen aktuální verze s odkazem, který čtenář po dočtení uvolní
+ * funkcí bst_persist_release. Verzi lze číst bez zámků libovolně dlouho,
+ * souběžné zápisy ji nemění. Čtenář nezamyká: kořen, který přebírá, ohlásí
+ * v jednom z BST_SHARED_HAZARDS míst (hazard pointer) a zapisovatel starou
+ * verzi uvolní až poté, co ji žádné místo neohlašuje. Pokud se kořen mezitím
+ * změnil, čtenář to zkusí znovu s novým kořenem.
+ */
+bst_node_t *bst_shared_snapshot(bst_shared_t *shared) {
+  for(;;)
+  {
+    bst_node_t *root = atomic_load(&shared->root);
+    if(!root) return NULL;
+
+    _Atomic(bst_node_t *) *hazard = claimHazard(shared, root);
+    bool current = atomic_load(&shared->root) == root;      // the writer did not see the hazard if the root changed
+    if(current)
+    {
+      bst_persist_retain(root);
+    }
+    atomic_store(hazard, NULL);
+
+    if(current) return root;
+  }
+}
+
+/*
+ * Zrušení sdíleného stromu.
+ *
+ * Verze, které si čtenáři ponechali, zůstávají platné až do jejich uvolnění.
+ */
+void bst_shared_dispose(bst_shared_t *shared) {
+  bst_persist_release(atomic_exchange(&shared->root, NULL));
+  mtx_destroy(&shared->write_lock);
+}
@@ -0,0 +1,41 @@
+/*
+ * Hlavičkový soubor pro perzistentní binární vyhledávací strom.
+ */
+
+#ifndef IAL_BTREE_PERSIST_H
+#define IAL_BTREE_PERSIST_H
+
+#include "../btree.h"
+#include <stdatomic.h>
+#include <threads.h>
+
+// Uzel perzistentního stromu, ukazatel na něj je zároveň ukazatelem na node
+typedef struct bst_pnode {
+  bst_node_t node;        // uzel se stejným rozložením jako v obyčejném stromu
+  atomic_int refs;        // počet odkazů z rodičů a kořenů verzí
+} bst_pnode_t;
+
+bst_node_t *bst_persist_insert(bst_node_t *root, char key, int value);
+bst_node_t *bst_persist_delete(bst_node_t *root, char key);
+void bst_persist_retain(bst_node_t *root);
+void bst_persist_release(bst_node_t *root);
+
+// Počet čtenářů, kteří mohou současně přebírat verzi, další čtenáři na volné místo čekají
+#ifndef BST_SHARED_HAZARDS
+#define BST_SHARED_HAZARDS 64
+#endif
+
+// Sdílený strom, do kterého zapisuje jeden zapisovatel po druhém a ze kterého čtou čtenáři
+typedef struct bst_shared {
+  _Atomic(bst_node_t *) root;                         // aktuální verze
+  _Atomic(bst_node_t *) hazards[BST_SHARED_HAZARDS];  // kořeny, které čtenáři právě přebírají, jinak NULL
+  mtx_t write_lock;                                   // řadí zapisovatele za sebe
+} bst_shared_t;
+
+bool bst_shared_init(bst_shared_t *shared);
+void bst_shared_insert(bst_shared_t *shared, char key, int value);
+void bst_shared_delete(bst_shared_t *shared, char key);
+bst_node_t *bst_shared_snapshot(bst_shared_t *shared);
+void bst_shared_dispose(bst_shared_t *shared);
+
+#endif
@@ -0,0 +1,127 @@
+#include "persist.h"
+#include "../test_check.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Number of reader threads and snapshots taken by each of them
+#define READERS 4
+#define SNAPSHOTS 2000
+
+void print_version(bst_node_t *root) {
+  bst_items_t items = {NULL, 0, 0};
+  bst_inorder(root, &items);
+  for (int i = 0; i < items.size; i++) {
+    bst_print_node(items.nodes[i]);
+  }
+  printf("\n");
+  free(items.nodes);
+}
+
+// Returns the insert of the whole base data as a new version
+bst_node_t *insert_base(void) {
+  bst_node_t *root = NULL;
+  for (int i = 0; i < base_data_count; i++) {
+    bst_node_t *next = bst_persist_insert(root, base_keys[i], base_values[i]);
+    bst_persist_release(root);
+    root = next;
+  }
+  return root;
+}
+
+bool contains(bst_node_t *root, char key) {
+  int value;
+  return bst_search(root, key, &value);
+}
+
+bst_shared_t shared;
+atomic_bool writer_done;
+
+int writer(void *arg) {
+  for (int key = -128; key < 128; key++) {
+    bst_shared_insert(&shared, (char)key, key);
+  }
+  for (int key = -128; key < 128; key++) {
+    bst_shared_delete(&shared, (char)key);
+  }
+  atomic_store(&writer_done, true);
+  return 0;
+}
+
+// Every snapshot must hold a run of consecutive keys with matching values and sizes
+int reader(void *arg) {
+  int *failures = arg;
+  for (int i = 0; i < SNAPSHOTS || !atomic_load(&writer_done); i++) {
+    bst_node_t *root = bst_shared_snapshot(&shared);
+    bst_items_t items = {NULL, 0, 0};
+    bst_inorder(root, &items);
+    if (items.size != bst_size(root)) {
+      (*failures)++;
+    }
+    for (int j = 1; j < items.size; j++) {
+      if (items.nodes[j]->key != items.nodes[j - 1]->key + 1 ||
+          items.nodes[j]->value != items.nodes[j]->key) {
+        (*failures)++;
+      }
+    }
+    free(items.nodes);
+    bst_persist_release(root);
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  printf("Persistent Binary Search Tree - testing script\n");
+  printf("----------------------------------------------\n\n");
+
+  printf("[test_persist_insert] Insert (P,16) into a new version\n");
+  bst_node_t *first = insert_base();
+  bst_node_t *second = bst_persist_insert(first, 'P', 16);
+  print_version(first);
+  print_version(second);
+  check(!contains(first, 'P') && contains(second, 'P') &&
+            bst_size(first) == 15 && bst_size(second) == 16 &&
+            second->left == first->left,
+        "Only the new version contains P and shares the left subtree");
+
+  printf("[test_persist_delete] Delete the root (H) in a new version\n");
+  bst_node_t *third = bst_persist_delete(second, 'H');
+  print_version(third);
+  check(contains(second, 'H') && !contains(third, 'H') &&
+            bst_size(third) == 15 && bst_rank(third, 'I') == 7,
+        "Only the old version contains H");
+
+  printf("[test_persist_delete_missing] Delete a missing key (X)\n");
+  bst_node_t *fourth = bst_persist_delete(third, 'X');
+  check(fourth == third, "Version did not change");
+
+  printf("[test_persist_release] Release the old versions\n");
+  bst_persist_release(first);
+  bst_persist_release(second);
+  bst_persist_release(fourth);
+  check(contains(third, 'P') && bst_size(third) == 15,
+        "Remaining version is intact");
+  bst_persist_release(third);
+
+  printf("[test_shared_snapshots] Read snapshots during concurrent updates\n");
+  bst_shared_init(&shared);
+  atomic_init(&writer_done, false);
+  thrd_t threads[READERS + 1];
+  int failures[READERS] = {0};
+  thrd_create(&threads[0], writer, NULL);
+  for (int i = 0; i < READERS; i++) {
+    thrd_create(&threads[i + 1], reader, &failures[i]);
+  }
+  int total_failures = 0;
+  for (int i = 0; i <= READERS; i++) {
+    thrd_join(threads[i], NULL);
+  }
+  for (int i = 0; i < READERS; i++) {
+    total_failures += failures[i];
+  }
+  bst_node_t *last = bst_shared_snapshot(&shared);
+  check(total_failures == 0 && last == NULL,
+        "Every snapshot was consistent and the tree ended empty");
+  bst_shared_dispose(&shared);
+
+  return tests_summary();
+}
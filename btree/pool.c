@@ -0,0 +1,112 @@
+/*
+ * Alokátor uzlů binárního vyhledávacího stromu.
+ *
+ * Uzly jsou vydávány ze souvislých bloků, uvolněné uzly se ukládají do
+ * seznamu volných uzlů a znovu se použijí při dalším vkládání. Celý strom
+ * lze zrušit uvolněním bloků bez průchodu stromem.
+ */
+
+#include "btree.h"
+#include <stdlib.h>
+
+// Size of the first chunk and the upper bound for chunk growth
+#define BST_POOL_FIRST_CHUNK 64
+#define BST_POOL_MAX_CHUNK 4096
+
+_Thread_local bst_pool_t *bst_pool = NULL;
+
+/*
+ * Inicializace alokátoru.
+ *
+ * Alokátor se stává aktivním přiřazením do proměnné bst_pool. Každý strom
+ * by měl mít vlastní alokátor a uzly stromu se nesmí mísit s uzly
+ * alokovanými v době, kdy byl aktivní jiný alokátor (nebo žádný).
+ *
+ * Proměnná bst_pool je lokální pro vlákno a alokátor nemá zámek. Alokátor
+ * smí být aktivní nejvýše v jednom vlákně a uzly z něj lze vkládat i rušit
+ * jen v tomto vlákně. Nově spuštěná vlákna začínají bez aktivního
+ * alokátoru a alokují uzly funkcí malloc.
+ */
+void bst_pool_init(bst_pool_t *pool) {
+  pool->chunks = NULL;
+  pool->free_nodes = NULL;
+}
+
+/*
+ * Zrušení stromu spolu se všemi bloky alokátoru.
+ *
+ * Strom se neprochází, uvolní se pouze bloky. Po zrušení se strom nachází ve
+ * stejném stavu jako po inicializaci a alokátor je možné dále používat.
+ */
+void bst_pool_dispose(bst_pool_t *pool, bst_node_t **tree) {
+  bst_chunk_t *chunk = pool->chunks;
+
+  while(chunk)                          // we release chunks one by one
+  {
+    bst_chunk_t *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+
+  bst_pool_init(pool);                  // pool is empty again
+  *tree = NULL;
+}
+
+/*
+ * Alokace uzlu.
+ *
+ * Je-li aktivní alokátor, uzel je přednostně převzat ze seznamu uvolněných
+ * uzlů, jinak je vydán z posledního bloku. Bez aktivního alokátoru se uzel
+ * alokuje funkcí malloc. Při nedostatku paměti funkce vrací NULL.
+ */
+bst_node_t *bst_node_alloc() {
+  if(!bst_pool)
+  {
+    return malloc(sizeof(bst_node_t));            // no pool, plain allocation
+  }
+
+  if(bst_pool->free_nodes)
+  {
+    bst_node_t *node = bst_pool->free_nodes;      // we reuse freed node
+    bst_pool->free_nodes = node->left;
+    return node;
+  }
+
+  bst_chunk_t *chunk = bst_pool->chunks;
+
+  if(!chunk || chunk->used == chunk->capacity)    // if the last chunk is full, we allocate a bigger one
+  {
+    int capacity = chunk ? chunk->capacity * 2 : BST_POOL_FIRST_CHUNK;
+    if(capacity > BST_POOL_MAX_CHUNK)
+    {
+      capacity = BST_POOL_MAX_CHUNK;
+    }
+
+    chunk = malloc(sizeof(bst_chunk_t) + capacity * sizeof(bst_node_t));
+    if(!chunk) return NULL;
+
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->next = bst_pool->chunks;
+    bst_pool->chunks = chunk;
+  }
+
+  return &chunk->nodes[chunk->used++];
+}
+
+/*
+ * Uvolnění uzlu.
+ *
+ * Je-li aktivní alokátor, uzel je vrácen do seznamu uvolněných uzlů, jinak se
+ * uvolní funkcí free.
+ */
+void bst_node_free(bst_node_t *node) {
+  if(!bst_pool)
+  {
+    free(node);
+    return;
+  }
+
+  node->left = bst_pool->free_nodes;    // we chain the node into the free list
+  bst_pool->free_nodes = node;
+}
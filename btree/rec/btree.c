@@ -52,26 +52,22 @@ bool bst_search(bst_node_t *tree, char key, int *value) {
   return false;
 }
 
-/*
- * Vložení uzlu do stromu.
- *
- * Pokud uzel se zadaným klíče už ve stromu existuje, nahraďte jeho hodnotu.
- * Jinak vložte nový listový uzel.
- *
- * Výsledný strom musí splňovat podmínku vyhledávacího stromu — levý podstrom
- * uzlu obsahuje jenom menší klíče, pravý větší. 
- *
- * Funkci implementujte rekurzivně bez použití vlastních pomocných funkcí.
- */
-void bst_insert(bst_node_t **tree, char key, int value) {
+// Function to insert the node recursively, returns depth of the new node or -1 if no node was added
+int insertAtDepth(bst_node_t **tree, char key, int value, int depth) {
+  int inserted = -1;
+
   if(*tree == NULL) {                           // if tree is empty
-    *tree = malloc(sizeof(bst_node_t));         // we allocate memory for new node
+    *tree = bst_node_alloc();                   // we allocate memory for new node
+    if(!*tree) return -1;                       // allocation check
     
     (*tree)->key = key;                         // we set key and value
     (*tree)->value = value;
+    (*tree)->size = 1;                          // new node is a subtree of one node
     
     (*tree)->left = NULL;                       // we set left and right subtree to NULL
     (*tree)->right = NULL;   
+
+    return depth;
   }
   
   else if(key == (*tree)->key) {                
@@ -79,13 +75,37 @@ void bst_insert(bst_node_t **tree, char key, int value) {
   }
   
   else if(key < (*tree)->key) {
-    bst_insert(&(*tree)->left, key, value);     // if key is less than tree->key, we recursively insert in left subtree
+    inserted = insertAtDepth(&(*tree)->left, key, value, depth + 1);    // if key is less than tree->key, we recursively insert in left subtree
   }
   
   else if(key > (*tree)->key) {
-    bst_insert(&(*tree)->right, key, value);    // if key is greater than tree->key, we recursively insert in right subtree
+    inserted = insertAtDepth(&(*tree)->right, key, value, depth + 1);   // if key is greater than tree->key, we recursively insert in right subtree
+  }
+
+  (*tree)->size = 1 + bst_size((*tree)->left) + bst_size((*tree)->right);  // we update the size on the way back
+  return inserted;
+}
+
+/*
+ * Vložení uzlu do stromu.
+ *
+ * Pokud uzel se zadaným klíče už ve stromu existuje, nahraďte jeho hodnotu.
+ * Jinak vložte nový listový uzel.
+ *
+ * Výsledný strom musí splňovat podmínku vyhledávacího stromu — levý podstrom
+ * uzlu obsahuje jenom menší klíče, pravý větší. 
+ *
+ * Funkci implementujte rekurzivně bez použití vlastních pomocných funkcí.
+ * Je-li nastaven parametr bst_alpha, příliš hluboko vložený uzel vyvolá
+ * přestavění podstromu funkcí bst_scapegoat.
+ */
+void bst_insert(bst_node_t **tree, char key, int value) {
+  int depth = insertAtDepth(tree, key, value, 0);
+
+  if(depth >= 0)                                // only a new node can make the tree too deep
+  {
+    bst_scapegoat(tree, key, depth);
   }
-  return;
 }
 
 /*
@@ -102,24 +122,19 @@ void bst_insert(bst_node_t **tree, char key, int value) {
  * Funkci implementujte rekurzivně bez použití vlastních pomocných funkcí.
  */
 void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree) {
-  if((*tree)->right) {                          // if right subtree isnt NULL
-    if((*tree)->right->right)                   // if right subtree of right subtree isnt NULL
-    {
-      bst_replace_by_rightmost(target, &(*tree)->right);    // we recursively search for rightmost node
-    }
-    else
-    {
-      target->key = (*tree)->right->key;       // we replace key and value of target with key and value of rightmost node
-      target->value = (*tree)->right->value;
-      
-      bst_node_t *tmp = (*tree)->right;        // we free the rightmost node
-      (*tree)->right = (*tree)->right->left;   // we set right subtree of tree to left subtree of rightmost node if it exists
-      free(tmp);
-      
-      return;
-    }
+  if((*tree)->right)                            // if right subtree isnt NULL
+  {
+    bst_replace_by_rightmost(target, &(*tree)->right);    // we recursively search for rightmost node
+    (*tree)->size--;                                      // rightmost node was removed from this subtree
+    return;
   }
-  
+
+  target->key = (*tree)->key;                   // we replace key and value of target with key and value of rightmost node
+  target->value = (*tree)->value;
+
+  bst_node_t *tmp = *tree;                      // we free the rightmost node
+  *tree = (*tree)->left;                        // we set the link to the rightmost node to its left subtree if it exists
+  bst_node_free(tmp);
 }
 
 /*
@@ -144,12 +159,14 @@ void bst_delete(bst_node_t **tree, char key) {
   if(key < (*tree)->key) 
   {
     bst_delete(&(*tree)->left, key);                    // if key is less than tree->key, we recursively delete in left subtree
+    (*tree)->size = 1 + bst_size((*tree)->left) + bst_size((*tree)->right);
     return;
   }
   
   if(key > (*tree)->key) 
   {
     bst_delete(&(*tree)->right, key);                   // if key is greater than tree->key, we recursively delete in right subtree
+    (*tree)->size = 1 + bst_size((*tree)->left) + bst_size((*tree)->right);
     return;
   }
   
@@ -157,7 +174,7 @@ void bst_delete(bst_node_t **tree, char key) {
   {
     bst_node_t *tmp = *tree;                            // if left subtree is empty, we replace tree with right subtree and free left subtree
     *tree = (*tree)->right;
-    free(tmp);
+    bst_node_free(tmp);
     return;
   }
   
@@ -165,11 +182,12 @@ void bst_delete(bst_node_t **tree, char key) {
   {
     bst_node_t *tmp = *tree;                            // if right subtree is empty, we replace tree with left subtree and free right subtree
     *tree = (*tree)->left;
-    free(tmp);
+    bst_node_free(tmp);
     return;
   }
   
   bst_replace_by_rightmost(*tree, &(*tree)->left);      // if both subtrees arent empty, we replace tree with rightmost node of left subtree
+  (*tree)->size--;
 }
 
 /*
@@ -186,7 +204,7 @@ void bst_dispose(bst_node_t **tree) {
   {
   bst_dispose(&(*tree)->right);   // recursively dispose right and left subtree
   bst_dispose(&(*tree)->left);    
-  free(*tree);
+  bst_node_free(*tree);
   *tree = NULL;
   }
   
@@ -245,4 +263,35 @@ void bst_postorder(bst_node_t *tree, bst_items_t *items) {
   }
   
   return;
-}
\ No newline at end of file
+}
+
+/*
+ * Průchod rozsahem klíčů <lo, hi>.
+ *
+ * Pro každý uzel s klíčem z rozsahu zavolá funkci visit, a to ve
+ * vzestupném pořadí klíčů. Do podstromů, které nemohou obsahovat klíč
+ * z rozsahu, funkce nesestupuje.
+ *
+ * Funkci implementujte rekurzivně bez použití vlastních pomocných funkcí.
+ */
+void bst_range(bst_node_t *tree, char lo, char hi, bst_visitor_t visit, void *data) {
+  if(tree)                                          // if tree contains nodes
+  {
+    if(lo < tree->key)
+    {
+      bst_range(tree->left, lo, hi, visit, data);   // only if left subtree can contain keys from the range
+    }
+
+    if(lo <= tree->key && tree->key <= hi)
+    {
+      visit(tree, data);                            // we visit the node between its subtrees
+    }
+
+    if(tree->key < hi)
+    {
+      bst_range(tree->right, lo, hi, visit, data);  // only if right subtree can contain keys from the range
+    }
+  }
+
+  return;
+}
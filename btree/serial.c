@@ -0,0 +1,211 @@
+/*
+ * Ukládání a načítání stromu v kompaktním binárním formátu.
+ *
+ * Strom se ukládá jako hlavička a za ní uzly v pořadí preorder. Každý uzel
+ * zabírá jeden bajt příznaků potomků, jeden bajt klíče a hodnotu kódovanou
+ * proměnnou délkou (malá čísla včetně záporných zabírají jeden bajt). Tvar
+ * stromu je dán příznaky, strom se proto načte jedním lineárním průchodem
+ * bez vyhledávání a má přesně stejný tvar jako strom uložený.
+ *
+ * Statické pole v Eytzingerově pořadí se ukládá přímo tak, jak leží
+ * v paměti, a lze jej namapovat ze souboru bez kopírování.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "btree.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// File signatures of the tree stream and of the flat array
+#define BST_SERIAL_MAGIC "BSTS"
+#define BST_FLAT_MAGIC "BSTF"
+
+// Flags byte of a serialized node
+#define BST_SERIAL_LEFT 1
+#define BST_SERIAL_RIGHT 2
+
+// Function to write the unsigned number in 7-bit groups, the high bit marks another group
+bool writeVarint(FILE *file, uint32_t number)
+{
+  while(number >= 0x80)
+  {
+    if(putc((int)(number & 0x7F) | 0x80, file) == EOF) return false;
+    number >>= 7;
+  }
+
+  return putc((int)number, file) != EOF;
+}
+
+// Function to read the number written by writeVarint
+bool readVarint(FILE *file, uint32_t *number)
+{
+  *number = 0;
+
+  for(int shift = 0; shift < 35; shift += 7)
+  {
+    int byte = getc(file);
+    if(byte == EOF) return false;
+
+    *number |= (uint32_t)(byte & 0x7F) << shift;
+    if(!(byte & 0x80)) return true;
+  }
+
+  return false;                                   // too many groups, the stream is corrupted
+}
+
+// Function to write the subtree in preorder
+bool writeNode(FILE *file, bst_node_t *node)
+{
+  int flags = (node->left ? BST_SERIAL_LEFT : 0) | (node->right ? BST_SERIAL_RIGHT : 0);
+  uint32_t value = ((uint32_t)node->value << 1) ^ (uint32_t)(node->value >> 31);  // sign goes to the lowest bit
+
+  if(putc(flags, file) == EOF || putc((unsigned char)node->key, file) == EOF) return false;
+  if(!writeVarint(file, value)) return false;
+
+  if(node->left && !writeNode(file, node->left)) return false;
+  if(node->right && !writeNode(file, node->right)) return false;
+
+  return true;
+}
+
+// Function to read the subtree written by writeNode with keys in <lo, hi>, budget is the number of nodes still allowed
+bool readNode(FILE *file, bst_node_t **tree, int lo, int hi, uint32_t *budget)
+{
+  int flags = getc(file);
+  int key = getc(file);
+  uint32_t value;
+
+  if(flags == EOF || key == EOF || !readVarint(file, &value)) return false;
+  if(*budget == 0) return false;                  // more nodes than the header says, this also bounds the recursion
+
+  key = (char)key;
+  if(key < lo || key > hi) return false;          // key would break the search tree order
+
+  bst_node_t *node = bst_node_alloc();            // nodes are allocated in preorder, as they come
+  if(!node) return false;
+  (*budget)--;
+
+  node->key = (char)key;
+  node->value = (int)((value >> 1) ^ -(value & 1));
+  node->left = NULL;
+  node->right = NULL;
+  *tree = node;                                   // node is linked first so that failure disposes it too
+
+  if((flags & BST_SERIAL_LEFT) && !readNode(file, &node->left, lo, key - 1, budget)) return false;
+  if((flags & BST_SERIAL_RIGHT) && !readNode(file, &node->right, key + 1, hi, budget)) return false;
+
+  node->size = 1 + bst_size(node->left) + bst_size(node->right);
+  return true;
+}
+
+/*
+ * Uložení stromu do souboru.
+ *
+ * Soubor musí být otevřen pro binární zápis. Při chybě zápisu vrací false.
+ */
+bool bst_save(bst_node_t *tree, FILE *file) {
+  if(fwrite(BST_SERIAL_MAGIC, 1, 4, file) != 4) return false;
+  if(!writeVarint(file, (uint32_t)bst_size(tree))) return false;
+
+  return !tree || writeNode(file, tree);
+}
+
+/*
+ * Načtení stromu ze souboru.
+ *
+ * Strom se sestaví jedním průchodem souborem ve stejném tvaru, v jakém byl
+ * uložen, uzly se alokují v pořadí preorder. Případný předchozí obsah
+ * stromu je nutné nejdříve zrušit. Je-li soubor poškozený, obsahuje-li
+ * jiný počet uzlů než hlavička nebo klíče porušující uspořádání stromu,
+ * nebo dojde paměť, vrací false a strom zůstane prázdný.
+ */
+bool bst_load(bst_node_t **tree, FILE *file) {
+  char magic[4];
+  uint32_t count;
+
+  *tree = NULL;
+
+  if(fread(magic, 1, 4, file) != 4 || memcmp(magic, BST_SERIAL_MAGIC, 4) != 0) return false;
+  if(!readVarint(file, &count) || count > UCHAR_MAX + 1) return false;   // char keys allow at most 256 nodes
+
+  uint32_t budget = count;
+  if(count > 0 && (!readNode(file, tree, CHAR_MIN, CHAR_MAX, &budget) || budget != 0))
+  {
+    bst_dispose(tree);                            // we do not leave a partial tree
+    return false;
+  }
+
+  return true;
+}
+
+// Function to get the offset of the values array, it follows the keys aligned to the size of int
+size_t flatValuesOffset(int size)
+{
+  size_t offset = 8 + (size_t)size + 1;
+  return (offset + sizeof(int) - 1) / sizeof(int) * sizeof(int);
+}
+
+/*
+ * Uložení statického pole do souboru.
+ *
+ * Pole se ukládá v paměťové reprezentaci tohoto počítače, soubor je tedy
+ * určen k namapování na stejné architektuře.
+ */
+bool bst_flat_save(bst_flat_t *flat, FILE *file) {
+  int32_t size = flat->size;
+  size_t offset = 8 + (size_t)size + 1;
+  size_t padding = flatValuesOffset(size) - offset;
+  char zeros[sizeof(int)] = {0};
+
+  return fwrite(BST_FLAT_MAGIC, 1, 4, file) == 4 &&
+         fwrite(&size, sizeof(size), 1, file) == 1 &&
+         fwrite(flat->keys, 1, size + 1, file) == (size_t)size + 1 &&
+         fwrite(zeros, 1, padding, file) == padding &&
+         fwrite(flat->values, sizeof(int), size + 1, file) == (size_t)size + 1;
+}
+
+/*
+ * Namapování statického pole ze souboru.
+ *
+ * Soubor uložený funkcí bst_flat_save se namapuje do paměti jen pro čtení
+ * a pole flat se odkáže přímo do mapované oblasti, nic se nekopíruje ani
+ * nealokuje. Stránky se načítají až při prvním přístupu. Pole se uvolní
+ * funkcí bst_flat_dispose. Při chybě vrací false a pole zůstane prázdné.
+ */
+bool bst_flat_map(bst_flat_t *flat, FILE *file) {
+  flat->keys = NULL;
+  flat->values = NULL;
+  flat->size = 0;
+  flat->map = NULL;
+  flat->map_size = 0;
+
+  if(fflush(file) == EOF || fseek(file, 0, SEEK_END) != 0) return false;
+
+  long length = ftell(file);
+  if(length < 8) return false;
+
+  void *map = mmap(NULL, (size_t)length, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+  if(map == MAP_FAILED) return false;
+
+  int32_t size;
+  memcpy(&size, (char *)map + 4, sizeof(size));
+
+  if(memcmp(map, BST_FLAT_MAGIC, 4) != 0 || size < 0 ||
+     flatValuesOffset(size) + ((size_t)size + 1) * sizeof(int) > (size_t)length)
+  {
+    munmap(map, (size_t)length);                  // not a flat array or a truncated one
+    return false;
+  }
+
+  flat->keys = (char *)map + 8;
+  flat->values = (int *)((char *)map + flatValuesOffset(size));
+  flat->size = size;
+  flat->map = map;
+  flat->map_size = (size_t)length;
+  return true;
+}
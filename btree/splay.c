@@ -0,0 +1,157 @@
+/*
+ * Samoupravující se (splay) varianta operací nad binárním vyhledávacím
+ * stromem.
+ *
+ * Každá operace přesune naposledy navštívený uzel rotacemi do kořene, takže
+ * často používané klíče zůstávají blízko kořene. Stromy vytvořené funkcemi
+ * bst_insert a bst_splay_insert jsou navzájem zaměnitelné, splay operace
+ * pouze mění jejich tvar a udržují velikosti podstromů.
+ */
+
+#include "btree.h"
+#include <stdlib.h>
+
+// Function to move the node with key, or the last node on its search path, to the root, returns the new root
+bst_node_t *splay(bst_node_t *tree, char key)
+{
+  if(!tree || key == tree->key) return tree;      // key is already in the root
+
+  if(key < tree->key)
+  {
+    if(!tree->left) return tree;                  // key is missing, tree is the last node on the path
+
+    if(key < tree->left->key)                     // zig-zig, we splay the grandchild and rotate the grandparent first
+    {
+      tree->left->left = splay(tree->left->left, key);
+      bst_rotate_right(&tree);
+    }
+    else if(key > tree->left->key)                // zig-zag, we splay the grandchild and rotate the parent first
+    {
+      tree->left->right = splay(tree->left->right, key);
+      if(tree->left->right)
+      {
+        bst_rotate_left(&tree->left);
+      }
+    }
+
+    if(tree->left)
+    {
+      bst_rotate_right(&tree);                    // the node on the path moves up to the root
+    }
+    return tree;
+  }
+  else
+  {
+    if(!tree->right) return tree;                 // key is missing, tree is the last node on the path
+
+    if(key > tree->right->key)                    // zig-zig, we splay the grandchild and rotate the grandparent first
+    {
+      tree->right->right = splay(tree->right->right, key);
+      bst_rotate_left(&tree);
+    }
+    else if(key < tree->right->key)               // zig-zag, we splay the grandchild and rotate the parent first
+    {
+      tree->right->left = splay(tree->right->left, key);
+      if(tree->right->left)
+      {
+        bst_rotate_right(&tree->right);
+      }
+    }
+
+    if(tree->right)
+    {
+      bst_rotate_left(&tree);                     // the node on the path moves up to the root
+    }
+    return tree;
+  }
+}
+
+/*
+ * Vyhledání uzlu se splay úpravou stromu.
+ *
+ * Návratová hodnota a value jako u bst_search. Nalezený uzel, nebo při
+ * neúspěchu poslední uzel na cestě vyhledávání, se přesune do kořene, proto
+ * funkce na rozdíl od bst_search přebírá ukazatel na kořen.
+ */
+bool bst_splay_search(bst_node_t **tree, char key, int *value) {
+  *tree = splay(*tree, key);
+
+  if(!*tree || (*tree)->key != key) return false;
+
+  *value = (*tree)->value;
+  return true;
+}
+
+/*
+ * Vložení uzlu se splay úpravou stromu.
+ *
+ * Chová se jako bst_insert, vložený nebo aktualizovaný uzel se však stane
+ * kořenem stromu. Při nedostatku paměti zůstane strom beze změny obsahu.
+ */
+void bst_splay_insert(bst_node_t **tree, char key, int value) {
+  bst_node_t *root = splay(*tree, key);
+  *tree = root;
+
+  if(root && root->key == key)
+  {
+    root->value = value;                          // key is already present, we replace value
+    return;
+  }
+
+  bst_node_t *node = bst_node_alloc();
+  if(!node) return;                               // allocation check
+
+  node->key = key;
+  node->value = value;
+
+  if(!root)                                       // tree was empty
+  {
+    node->left = NULL;
+    node->right = NULL;
+  }
+  else if(key < root->key)                        // root is the successor of key, its left subtree is smaller
+  {
+    node->left = root->left;
+    node->right = root;
+    root->left = NULL;
+    root->size = 1 + bst_size(root->right);
+  }
+  else                                            // root is the predecessor of key, its right subtree is greater
+  {
+    node->left = root;
+    node->right = root->right;
+    root->right = NULL;
+    root->size = 1 + bst_size(root->left);
+  }
+
+  node->size = 1 + bst_size(node->left) + bst_size(node->right);
+  *tree = node;
+}
+
+/*
+ * Odstranění uzlu se splay úpravou stromu.
+ *
+ * Chová se jako bst_delete. Odstraněný uzel se přesune do kořene a nahradí
+ * jej největší uzel levého podstromu. Pokud klíč ve stromu není, v kořeni
+ * zůstane poslední uzel na cestě vyhledávání.
+ */
+void bst_splay_delete(bst_node_t **tree, char key) {
+  bst_node_t *root = splay(*tree, key);
+  *tree = root;
+
+  if(!root || root->key != key) return;           // key is missing
+
+  if(!root->left)
+  {
+    *tree = root->right;
+  }
+  else
+  {
+    bst_node_t *left = splay(root->left, key);    // all keys are smaller, so the greatest one rises with no right child
+    left->right = root->right;
+    left->size = 1 + bst_size(left->left) + bst_size(left->right);
+    *tree = left;
+  }
+
+  bst_node_free(root);
+}
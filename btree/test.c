@@ -1,7 +1,9 @@
 #include "btree.h"
 #include "test_util.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 const int base_data_count = 15;
 const char base_keys[] = {'H', 'D', 'L', 'B', 'F', 'J', 'N', 'A',
@@ -35,6 +37,25 @@ void reset_color(){
 int tests_passed = 0;
 int tests_failed;
 
+// Loads the stream written into a temporary file, a loaded tree is disposed
+bool load_bytes(const unsigned char *bytes, size_t length) {
+  FILE *file = tmpfile();
+  bst_node_t *tree;
+  bool loaded = file != NULL && fwrite(bytes, 1, length, file) == length &&
+                fseek(file, 0, SEEK_SET) == 0 && bst_load(&tree, file);
+  if (loaded) {
+    bst_dispose(&tree);
+  }
+  if (file != NULL) {
+    fclose(file);
+  }
+  return loaded;
+}
+
+void dense_sum_visitor(char key, int value, void *data) {
+  *(long long *)data += value;
+}
+
 void init_test() {
   printf("Binary Search Tree - testing script\n");
   printf("-----------------------------------\n");
@@ -401,6 +422,409 @@ reset_color();
 bst_print_items(test_items);
 ENDTEST
 
+TEST(test_tree_pool, "Build, update and dispose the tree using a node pool")
+bst_pool_t pool;
+bst_pool_init(&pool);
+bst_pool = &pool;
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_delete(&test_tree, 'H');
+bst_insert(&test_tree, 'H', 8);
+bst_print_tree(test_tree);
+int found = 0;
+for (int i = 0; i < base_data_count; i++) {
+  int result;
+  if (bst_search(test_tree, base_keys[i], &result) && result == base_values[i]) {
+    found++;
+  }
+}
+bst_pool_dispose(&pool, &test_tree);
+bst_pool = NULL;
+if (found == base_data_count && test_tree == NULL){
+  green();
+  printf("Pooled tree was built and disposed correctly: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Pooled tree was NOT built and disposed correctly: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_tree_flat_search, "Search in the compiled Eytzinger array")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_flat_t flat;
+bst_compile(test_tree, &flat);
+int found = 0;
+for (int i = 0; i < base_data_count; i++) {
+  int result;
+  if (bst_flat_search(&flat, base_keys[i], &result) && result == base_values[i]) {
+    found++;
+  }
+}
+int result;
+bool bool_res = bst_flat_search(&flat, 'X', &result) || bst_flat_search(&flat, '0', &result);
+bst_flat_dispose(&flat);
+if (found == base_data_count && bool_res == false){
+  green();
+  printf("All keys were found in the compiled array: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Keys were NOT found correctly in the compiled array: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_tree_order_statistics, "Rank, select and count a range (median, <C, J>)")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_delete(&test_tree, 'D');
+bst_print_tree(test_tree);
+bst_node_t *median = bst_select(test_tree, bst_size(test_tree) / 2);
+int rank = bst_rank(test_tree, 'J');
+int count = bst_count_range(test_tree, 'C', 'J');
+cyan();
+printf("\n");
+printf("-----------------------------------------------------------\n");
+printf("|  Correct output below should be: 14 nodes, [I,9], 8, 7  |\n");
+printf("-----------------------------------------------------------\n");
+printf("\n");
+reset_color();
+printf("%d nodes, ", bst_size(test_tree));
+if (median != NULL) {
+  bst_print_node(median);
+}
+printf(", %d, %d\n\n", rank, count);
+if (bst_size(test_tree) == 14 && median != NULL && median->key == 'I' &&
+    rank == 8 && count == 7 && bst_select(test_tree, 14) == NULL){
+  green();
+  printf("Order statistics are correct: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Order statistics are NOT correct: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+void add_visited_node(bst_node_t *node, void *items) {
+  bst_add_node_to_items(node, items);
+}
+
+TEST(test_tree_range, "Traverse the range <C, J> of the tree")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_range(test_tree, 'C', 'J', add_visited_node, test_items);
+bst_print_tree(test_tree);
+cyan();
+printf("\n");
+printf("-------------------------------------------------------------------------------\n");
+printf("|  Correct output below should be: [C,3][D,4][E,5][F,6][G,7][H,8][I,9][J,10]  |\n");
+printf("-------------------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bst_print_items(test_items);
+ENDTEST
+
+TEST(test_tree_range_deep, "Traverse ranges of a left spine 100 nodes deep")
+bst_init(&test_tree);
+for (int key = 126; key > 26; key--) {
+  bst_insert(&test_tree, (char)key, key);   // descending keys, every node is a left child
+}
+bst_range(test_tree, 40, 120, add_visited_node, test_items);
+bool ordered = test_items->size == 81;
+for (int i = 0; ordered && i < test_items->size; i++) {
+  ordered = test_items->nodes[i]->key == 40 + i;
+}
+test_items->size = 0;
+bst_range(test_tree, CHAR_MIN, CHAR_MAX, add_visited_node, test_items);
+ordered = ordered && test_items->size == 100 && test_items->nodes[99]->key == 126;
+if (ordered) {
+  green();
+  printf("Deep ranges are complete and ordered: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Deep ranges are NOT complete and ordered: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_tree_build_from_array, "Build a balanced tree from an unsorted array")
+const char build_keys[] = {'G', 'A', 'E', 'C', 'B', 'F', 'D', 'A'};
+const int build_values[] = {7, 0, 5, 3, 2, 6, 4, 1};
+bst_build_from_array(&test_tree, build_keys, build_values, 8);
+bst_inorder(test_tree, test_items);
+cyan();
+printf("\n");
+printf("---------------------------------------------------------------------------\n");
+printf("|  If you implemented the bst_build_from_array() correctly, output below  |\n");
+printf("|  should be a complete tree of height 3 rooted in [D,4] and the items    |\n");
+printf("|  [A,1][B,2][C,3][D,4][E,5][F,6][G,7]                                    |\n");
+printf("---------------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bst_print_tree(test_tree);
+bst_print_items(test_items);
+ENDTEST
+
+int tree_height(bst_node_t *tree) {
+  if (tree == NULL) {
+    return 0;
+  }
+  int left_height = tree_height(tree->left);
+  int right_height = tree_height(tree->right);
+  return 1 + (left_height > right_height ? left_height : right_height);
+}
+
+TEST(test_tree_scapegoat, "Insert 100 sorted keys with automatic balancing (alpha 0.7)")
+bst_init(&test_tree);
+bst_alpha = 0.7;
+for (int i = 0; i < 100; i++) {
+  bst_insert(&test_tree, (char)(20 + i), i);
+}
+bst_alpha = 0;
+bool all_found = true;
+for (int i = 0; i < 100; i++) {
+  int value;
+  if (!bst_search(test_tree, (char)(20 + i), &value) || value != i) {
+    all_found = false;
+  }
+}
+int height = tree_height(test_tree);
+cyan();
+printf("\n");
+printf("----------------------------------------------------------------------\n");
+printf("|  Correct output below should be: 100 nodes of height at most 14  |\n");
+printf("----------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+printf("%d nodes of height %d\n\n", bst_size(test_tree), height);
+if (all_found && bst_size(test_tree) == 100 && height <= 14){
+  green();
+  printf("Tree stayed balanced: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Tree did NOT stay balanced: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_tree_splay, "Splay search, insert and delete (A, (P,16), H)")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+int value = 0;
+bool found = bst_splay_search(&test_tree, 'A', &value);
+char after_search = test_tree->key;
+int search_value = value;
+bst_splay_insert(&test_tree, 'P', 16);
+char after_insert = test_tree->key;
+bst_splay_delete(&test_tree, 'H');
+bst_print_tree(test_tree);
+cyan();
+printf("\n");
+printf("------------------------------------------------------------\n");
+printf("|  Correct output below should be: A 1, P, 15 nodes, no H  |\n");
+printf("------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bool found_deleted = bst_search(test_tree, 'H', &value);
+printf("%c %d, %c, %d nodes%s\n\n", after_search, search_value, after_insert,
+       bst_size(test_tree), found_deleted ? "" : ", no H");
+if (found && after_search == 'A' && search_value == 1 && after_insert == 'P' &&
+    bst_size(test_tree) == 15 && !found_deleted){
+  green();
+  printf("Splay operations are correct: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Splay operations are NOT correct: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_tree_save_load, "Save and load the tree, save and map its compiled array")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_insert(&test_tree, 'Z', -300);
+FILE *file = tmpfile();
+bst_node_t *loaded_tree;
+bool loaded = file != NULL && bst_save(test_tree, file) && fseek(file, 0, SEEK_SET) == 0 &&
+              bst_load(&loaded_tree, file);
+bst_items_t *loaded_items = bst_init_items();
+bool same = false;
+if (loaded) {
+  bst_print_tree(loaded_tree);
+  bst_preorder(test_tree, test_items);
+  bst_preorder(loaded_tree, loaded_items);
+  same = test_items->size == loaded_items->size && bst_size(loaded_tree) == 16;
+  for (int i = 0; same && i < test_items->size; i++) {
+    same = test_items->nodes[i]->key == loaded_items->nodes[i]->key &&
+           test_items->nodes[i]->value == loaded_items->nodes[i]->value;
+  }
+  bst_dispose(&loaded_tree);
+}
+bst_reset_items(loaded_items);
+free(loaded_items);
+if (file != NULL) {
+  fclose(file);
+}
+// header with the node count, then flags (1 = left child), key and value of each node
+const unsigned char unordered[] = {'B', 'S', 'T', 'S', 2, 1, 'B', 0, 0, 'C', 0};
+const unsigned char too_many[] = {'B', 'S', 'T', 'S', 0xE8, 0x07, 0, 'A', 0};
+size_t chain_length = 5 + 3 * 100000;
+unsigned char *chain = malloc(chain_length);
+bool rejected = chain != NULL;
+if (chain != NULL) {
+  memcpy(chain, "BSTS\2", 5);
+  for (size_t i = 5; i < chain_length; i += 3) {
+    chain[i] = i + 3 < chain_length; // the last node of the chain is a leaf
+    chain[i + 1] = (unsigned char)('Z' - (i / 3) % 26);
+    chain[i + 2] = 0;
+  }
+  rejected = !load_bytes(unordered, sizeof(unordered)) &&
+             !load_bytes(too_many, sizeof(too_many)) &&
+             !load_bytes(chain, chain_length);
+  free(chain);
+}
+bst_flat_t flat;
+bst_compile(test_tree, &flat);
+file = tmpfile();
+bool mapped = file != NULL && bst_flat_save(&flat, file);
+bst_flat_dispose(&flat);
+mapped = mapped && bst_flat_map(&flat, file);
+int result = 0;
+bool found = mapped && bst_flat_search(&flat, 'Z', &result) && result == -300 &&
+             !bst_flat_search(&flat, 'X', &result);
+bst_flat_dispose(&flat);
+if (file != NULL) {
+  fclose(file);
+}
+if (loaded && same && found && rejected){
+  green();
+  printf("Loaded tree and mapped array are the same: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Loaded tree or mapped array is NOT the same: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_tree_top_k, "Select 8 nodes with the greatest values (ties by key)")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_insert_many(&test_tree, additional_keys, additional_values, additional_data_count);
+bst_top_k(test_tree, 8, test_items);
+cyan();
+printf("\n");
+printf("--------------------------------------------------------------------------------------\n");
+printf("|  Correct output below should be: [O,16][N,14][M,13][L,12][K,11][J,10][P,10][Q,10]  |\n");
+printf("--------------------------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bst_print_items(test_items);
+const char top_keys[] = {'O', 'N', 'M', 'L', 'K', 'J', 'P', 'Q'};
+bool correct = test_items->size == 8;
+for (int i = 0; correct && i < 8; i++) {
+  correct = test_items->nodes[i]->key == top_keys[i];
+}
+bst_reset_items(test_items);
+bst_top_k(test_tree, 100, test_items);
+if (correct && test_items->size == bst_size(test_tree)){
+  green();
+  printf("Nodes with the greatest values are correct: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Nodes with the greatest values are NOT correct: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_dense_map, "Direct-indexed map: rank, select, next and a range (median, <C, J>)")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_dense_t dense;
+bst_dense_from_tree(&dense, test_tree);
+bst_dense_delete(&dense, 'D');
+bst_dense_insert(&dense, 'H', 80);
+char median = 0, next = 0;
+long long sum = 0;
+bool selected = bst_dense_select(&dense, bst_dense_size(&dense) / 2, &median);
+bool has_next = bst_dense_next(&dense, 'D', &next);
+bst_dense_range(&dense, 'C', 'J', dense_sum_visitor, &sum);
+int value = 0;
+cyan();
+printf("\n");
+printf("-----------------------------------------------------------------\n");
+printf("|  Correct output below should be: 14 keys, I, 8, E, 120, H 80  |\n");
+printf("-----------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bool found = bst_dense_search(&dense, 'H', &value);
+printf("%d keys, %c, %d, %c, %lld, H %d\n\n", bst_dense_size(&dense), median,
+       bst_dense_rank(&dense, 'J'), next, sum, value);
+if (bst_dense_size(&dense) == 14 && selected && median == 'I' &&
+    bst_dense_rank(&dense, 'J') == 8 && has_next && next == 'E' && sum == 120 &&
+    found && value == 80 && !bst_dense_search(&dense, 'D', &value) &&
+    !bst_dense_select(&dense, 14, &median) && !bst_dense_next(&dense, 'O', &next)){
+  green();
+  printf("Direct-indexed map is correct: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Direct-indexed map is NOT correct: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_tree_split_join, "Split the tree at H, join it back and join (A,100),(Z,26)")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_node_t *lower, *upper, *other;
+bst_split(&test_tree, 'H', &lower, &upper);
+bool split_ok = test_tree == NULL && bst_size(lower) == 7 &&
+                bst_size(upper) == 8 && upper->key == 'H';
+test_tree = lower;
+bst_join(&test_tree, &upper);
+bst_init(&other);
+bst_insert(&other, 'A', 100);
+bst_insert(&other, 'Z', 26);
+bst_join(&test_tree, &other);
+bst_print_tree(test_tree);
+int result = 0;
+bool join_ok = upper == NULL && other == NULL && bst_size(test_tree) == 16 &&
+               bst_search(test_tree, 'A', &result) && result == 100 &&
+               bst_rank(test_tree, 'Z') == 15;
+// balanced trees of 100 and 27 keys are at most one level taller when joined
+char keys[127];
+int values[127];
+for (int i = 0; i < 127; i++) {
+  keys[i] = (char)(i - 64);
+  values[i] = i;
+}
+bst_build_from_sorted(&lower, keys, values, 100);
+bst_build_from_sorted(&upper, keys + 100, values + 100, 27);
+int taller = tree_height(lower) > tree_height(upper) ? tree_height(lower) : tree_height(upper);
+bst_join(&upper, &lower);
+bool height_ok = bst_size(upper) == 127 && tree_height(upper) <= taller + 1 &&
+                 bst_rank(upper, 62) == 126;
+bst_dispose(&upper);
+if (split_ok && join_ok && height_ok){
+  green();
+  printf("Tree was split and joined correctly: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Tree was NOT split or joined correctly: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
 #ifdef EXA
 
 TEST(test_letter_count, "Count letters");
@@ -409,6 +833,137 @@ letter_count(&test_tree, "abBcCc_ 123 *");
 bst_print_tree(test_tree);
 ENDTEST
 
+TEST(test_letter_count_parallel, "Count 10000 letters using 3 threads and compare with letter_count")
+bst_init(&test_tree);
+int length = 10000;
+char *input = malloc(length + 1);
+bool same = false;
+if (input != NULL) {
+  unsigned state = 1;
+  for (int i = 0; i < length; i++) {
+    state = state * 1103515245u + 12345u;
+    input[i] = (char)(' ' + (state >> 16) % 95); // printable ASCII
+  }
+  input[length] = '\0';
+  bst_node_t *serial_tree;
+  letter_count(&serial_tree, input);
+  letter_count_parallel(&test_tree, input, 3);
+  bst_items_t *serial_items = bst_init_items();
+  bst_inorder(serial_tree, serial_items);
+  bst_inorder(test_tree, test_items);
+  same = bst_size(test_tree) == bst_size(serial_tree) &&
+         test_items->size == serial_items->size && test_items->size > 0;
+  for (int i = 0; same && i < test_items->size; i++) {
+    same = test_items->nodes[i]->key == serial_items->nodes[i]->key &&
+           test_items->nodes[i]->value == serial_items->nodes[i]->value;
+  }
+  bst_reset_items(serial_items);
+  free(serial_items);
+  bst_dispose(&serial_tree);
+  free(input);
+}
+if (same){
+  green();
+  printf("Parallel count is the same as letter_count: [TEST PASSED ✓]\n\n");
+  tests_passed++;
+} else {
+  red();
+  printf("Parallel count is NOT the same as letter_count: [TEST FAILED ☓]\n\n");
+}
+reset_color();
+ENDTEST
+
+TEST(test_letter_count_file, "Count letters of a file read in blocks");
+bst_init(&test_tree);
+FILE *file = tmpfile();
+if (file != NULL) {
+  fputs("abBcCc_ 123 *", file);
+  rewind(file);
+}
+cyan();
+printf("\n");
+printf("-------------------------------------------------------------------\n");
+printf("|  Correct output below should be the same tree as in the output  |\n");
+printf("|  of test_letter_count                                           |\n");
+printf("-------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+if (file != NULL && letter_count_file(&test_tree, file)) {
+  bst_print_tree(test_tree);
+} else {
+  printf("File could not be read\n");
+}
+if (file != NULL) {
+  fclose(file);
+}
+ENDTEST
+
+TEST(test_letter_count_map, "Count letters of a mapped file");
+bst_init(&test_tree);
+FILE *file = tmpfile();
+if (file != NULL) {
+  fputs("abBcCc_ 123 *", file);
+  fflush(file);
+}
+cyan();
+printf("\n");
+printf("-------------------------------------------------------------------\n");
+printf("|  Correct output below should be the same tree as in the output  |\n");
+printf("|  of test_letter_count                                           |\n");
+printf("-------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+if (file != NULL && letter_count_map(&test_tree, file)) {
+  bst_print_tree(test_tree);
+} else {
+  printf("File could not be mapped\n");
+}
+if (file != NULL) {
+  fclose(file);
+}
+ENDTEST
+
+TEST(test_letter_count_add, "Count letters in two chunks \"abBcCc\", \"_ 123 *\"");
+letter_count(&test_tree, "abBcCc");
+letter_count_add(&test_tree, "_ 123 *");
+cyan();
+printf("\n");
+printf("-------------------------------------------------------------------\n");
+printf("|  Correct output below should be the same tree as in the output  |\n");
+printf("|  of test_letter_count                                           |\n");
+printf("-------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_letter_count_saturate, "Add the chunk \"aaa\" to the count INT_MAX - 1");
+bst_init(&test_tree);
+bst_insert(&test_tree, 'a', INT_MAX - 1);
+letter_count_add(&test_tree, "aaa");
+cyan();
+printf("\n");
+printf("---------------------------------------------------------\n");
+printf("|  Correct output below should be: root [a,2147483647]  |\n");
+printf("---------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_letter_count_subtract, "Count letters and subtract the chunk \"AbB 1\"");
+letter_count(&test_tree, "abBcCc_ 123 *");
+letter_count_subtract(&test_tree, "AbB 1");
+cyan();
+printf("\n");
+printf("-------------------------------------------------------------------------\n");
+printf("|  Correct output below should be: root [_,4], left [ ,1], right [c,3]  |\n");
+printf("-------------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bst_print_tree(test_tree);
+ENDTEST
+
 TEST(test_balance, "Count letters and balance");
 bst_init(&test_tree);
 letter_count(&test_tree, "abBcCc_ 123 *");
@@ -416,6 +971,23 @@ bst_balance(&test_tree);
 bst_print_tree(test_tree);
 ENDTEST
 
+TEST(test_balance_dsw, "Insert sorted keys and balance in place");
+bst_init(&test_tree);
+for (int i = 0; i < base_data_count; i++) {
+  bst_insert(&test_tree, 'A' + i, i + 1);
+}
+bst_balance_dsw(&test_tree);
+cyan();
+printf("\n");
+printf("---------------------------------------------------------------------------\n");
+printf("|  Correct output below should be a complete tree of height 4 with [H,8]  |\n");
+printf("|  in the root                                                            |\n");
+printf("---------------------------------------------------------------------------\n");
+printf("\n");
+reset_color();
+bst_print_tree(test_tree);
+ENDTEST
+
 #endif // EXA
 
 int main(int argc, char *argv[]) {
@@ -440,8 +1012,24 @@ int main(int argc, char *argv[]) {
   test_tree_preorder();
   test_tree_inorder();
   test_tree_postorder();
-  
-  tests_failed = 11 - tests_passed;
+  test_tree_pool();
+  test_tree_flat_search();
+  test_tree_order_statistics();
+  test_tree_range();
+  test_tree_range_deep();
+  test_tree_build_from_array();
+  test_tree_scapegoat();
+  test_tree_splay();
+  test_tree_save_load();
+  test_tree_top_k();
+  test_dense_map();
+  test_tree_split_join();
+#ifdef EXA
+  test_letter_count_parallel();
+  tests_failed = 22 - tests_passed;
+#else
+  tests_failed = 21 - tests_passed;
+#endif
   printf("\n");
   printf("---------- TESTS SUMMARY ----------\n");
   printf("|                                 |\n");
@@ -466,7 +1054,13 @@ int main(int argc, char *argv[]) {
 
 #ifdef EXA
   test_letter_count();
+  test_letter_count_file();
+  test_letter_count_map();
+  test_letter_count_add();
+  test_letter_count_saturate();
+  test_letter_count_subtract();
   test_balance();
+  test_balance_dsw();
 #endif // EXA
 }
 
@@ -0,0 +1,29 @@
+#include "test_check.h"
+#include <stdio.h>
+
+const int base_data_count = 15;
+const char base_keys[] = {'H', 'D', 'L', 'B', 'F', 'J', 'N', 'A',
+                          'C', 'E', 'G', 'I', 'K', 'M', 'O'};
+const int base_values[] = {8, 4, 12, 2, 6, 10, 14, 1, 3, 5, 7, 9, 11, 13, 16};
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+void check(bool passed, const char *description) {
+  if (passed) {
+    printf("\033[1;32m%s: [TEST PASSED ✓]\033[0m\n\n", description);
+    tests_passed++;
+  } else {
+    printf("\033[1;31m%s: [TEST FAILED ☓]\033[0m\n\n", description);
+    tests_failed++;
+  }
+}
+
+// Prints the summary and returns the exit status of the test program
+int tests_summary() {
+  printf("---------- TESTS SUMMARY ----------\n");
+  printf(" TESTS PASSED: %d\n", tests_passed);
+  printf(" TESTS FAILED: %d\n", tests_failed);
+  printf("-----------------------------------\n");
+  return tests_failed != 0;
+}
@@ -0,0 +1,17 @@
+#ifndef IAL_BTREE_TEST_CHECK_H
+#define IAL_BTREE_TEST_CHECK_H
+
+#include <stdbool.h>
+
+// Keys and values of the base tree, the same data as in test.c
+extern const int base_data_count;
+extern const char base_keys[];
+extern const int base_values[];
+
+extern int tests_passed;
+extern int tests_failed;
+
+void check(bool passed, const char *description);
+int tests_summary();
+
+#endif
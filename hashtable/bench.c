@@ -0,0 +1,94 @@
+/*
+ * Škálovatelné měření operací tabulky s rozptýlenými položkami.
+ *
+ * Klíče jsou řetězce ze slovníku 256 klíčů vybírané podle rozdělení
+ * (rovnoměrné, vzestupné, sestupné a Zipfovo), stejně jako u měření
+ * binárního stromu. Pro každou velikost od nejmenší po největší, vždy
+ * desetinásobnou, se změří size vložení, vyhledání, získání hodnoty
+ * a odstranění. Velikost je tedy počet operací a tabulka obsahuje nejvýše
+ * 256 položek.
+ *
+ * Program se spouští jako bench [největší velikost [nejmenší velikost]],
+ * výchozí rozsah je 10^2 až 10^8. Výstupem jsou řádky CSV ve tvaru
+ * engine,operace,rozdělení,velikost,počet operací,ns/op,op/s,RSS v kB.
+ *
+ * Proměnná prostředí BENCH_PERF přidá sloupce hardwarových čítačů na
+ * operaci stejně jako u měření binárního stromu.
+ */
+
+#include "hashtable.h"
+#include "../btree/bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+volatile float sink = 0;
+
+// Keys of all ranks, the table stores only pointers to them
+char keys[256][8];
+
+void bench_size(ht_table_t *table, bench_distribution_t distribution,
+                long long size, unsigned char *ranks) {
+  ht_init(table);
+  long long start = bench_start();
+  for (long long i = 0; i < size; i++) {
+    ht_insert(table, keys[ranks[i]], (float)i);
+  }
+  bench_report_sized("hashtable", "insert", distribution, size, size,
+                     bench_now_ns() - start);
+
+  start = bench_start();
+  for (long long i = 0; i < size; i++) {
+    ht_item_t *item = ht_search(table, keys[ranks[size - 1 - i]]);
+    if (item) {
+      sink += item->value;
+    }
+  }
+  bench_report_sized("hashtable", "search", distribution, size, size,
+                     bench_now_ns() - start);
+
+  start = bench_start();
+  for (long long i = 0; i < size; i++) {
+    float *value = ht_get(table, keys[ranks[i]]);
+    if (value) {
+      sink += *value;
+    }
+  }
+  bench_report_sized("hashtable", "get", distribution, size, size,
+                     bench_now_ns() - start);
+
+  start = bench_start();
+  for (long long i = 0; i < size; i++) {
+    ht_delete(table, keys[ranks[i]]);
+  }
+  bench_report_sized("hashtable", "delete", distribution, size, size,
+                     bench_now_ns() - start);
+  ht_delete_all(table);
+}
+
+int main(int argc, char *argv[]) {
+  long long max_size = argc > 1 ? atoll(argv[1]) : 100000000;
+  long long min_size = argc > 2 ? atoll(argv[2]) : 100;
+  if (min_size < 1) min_size = 1;
+  if (max_size < min_size) max_size = min_size;
+
+  unsigned char *ranks = malloc(max_size);
+  ht_table_t *table = malloc(sizeof(ht_table_t));
+  if (!ranks || !table) return 1;
+
+  for (int i = 0; i < 256; i++) {
+    snprintf(keys[i], sizeof(keys[i]), "key%03d", i);
+  }
+
+  bench_report_header();
+  for (int distribution = 0; distribution < BENCH_DISTRIBUTIONS; distribution++) {
+    unsigned state = 2463534242u;
+    for (long long size = min_size; size <= max_size; size *= 10) {
+      bench_fill_ranks(ranks, size, distribution, &state);
+      bench_size(table, distribution, size, ranks);
+    }
+  }
+
+  free(ranks);
+  free(table);
+  return 0;
+}
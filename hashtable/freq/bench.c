@@ -0,0 +1,114 @@
+/*
+ * Porovnání přesného počítání slov s režimy Space-Saving a Count-Min Sketch.
+ *
+ * Text obsahuje slova ze slovníku o VOCABULARY slovech se Zipfovým
+ * rozdělením, počet slov textu je prvním argumentem programu. Výstupem
+ * jsou nejprve řádky CSV ve tvaru engine,operace,počet operací,ns/op,op/s
+ * a po prázdném řádku tabulka CSV s pamětí a chybou odhadu každého
+ * režimu. Chyba se u Count-Min Sketch měří přes všechna slova textu,
+ * u Space-Saving přes TOP_WORDS nejčastějších slov, která mají být
+ * sledována.
+ */
+
+#include "freq.h"
+#include "../../btree/bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of distinct words the text is drawn from
+#define VOCABULARY 100000
+
+// Number of the most frequent words checked in Space-Saving mode
+#define TOP_WORDS 100
+
+// Slots of the Space-Saving counter and error bounds of the sketch
+#define HEAVY_SLOTS 1000
+#define SKETCH_EPSILON 0.0001
+#define SKETCH_DELTA 0.01
+
+// Memory used by the counter, blocks of interned keys are counted whole
+size_t counter_memory(freq_counter_t *counter) {
+  size_t memory = sizeof(freq_counter_t) + counter->token_capacity +
+                  sizeof(ht_item_t *) * counter->bucket_count;
+  for (freq_block_t *block = counter->blocks; block; block = block->next) {
+    memory += sizeof(freq_block_t) + block->size;
+  }
+  for (int i = 0; i < counter->capacity; i++) {
+    memory += sizeof(freq_slot_t) + sizeof(freq_slot_t *) +
+              counter->slots[i].key_capacity;
+  }
+  return memory + sizeof(long long) * counter->width * counter->depth;
+}
+
+void bench_count(const char *engine, freq_counter_t *counter, const char *text,
+                 size_t length, int words) {
+  long long start = bench_start();
+  freq_count(counter, text, length);
+  freq_finish(counter);
+  bench_report(engine, "count_word", words, bench_now_ns() - start);
+}
+
+int main(int argc, char *argv[]) {
+  int words = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (words < 1) words = 1;
+
+  bench_zipf_t zipf;
+  char *text = malloc((size_t)words * 8 + 1); // "w99999 " is the longest word
+  if (!text || !bench_zipf_init(&zipf, VOCABULARY)) return 1;
+
+  unsigned state = 2463534242u;
+  size_t length = 0;
+  for (int i = 0; i < words; i++) {
+    length += sprintf(text + length, "w%d ", bench_zipf(&zipf, &state));
+  }
+  bench_zipf_dispose(&zipf);
+
+  freq_counter_t exact, heavy, sketch;
+  if (!freq_init(&exact, FREQ_WORDS, 0) ||
+      !freq_init_heavy(&heavy, FREQ_WORDS, 0, HEAVY_SLOTS) ||
+      !freq_init_sketch(&sketch, FREQ_WORDS, 0, SKETCH_EPSILON, SKETCH_DELTA)) {
+    return 1;
+  }
+
+  printf("engine,operation,ops,ns_per_op,ops_per_s%s\n", bench_perf_columns());
+  bench_count("freq-exact", &exact, text, length, words);
+  bench_count("freq-heavy", &heavy, text, length, words);
+  bench_count("freq-sketch", &sketch, text, length, words);
+
+  // the exact counts are the reference for both approximations
+  freq_entry_t *entries = freq_sorted(&exact);
+  if (!entries) return 1;
+
+  double sketch_error = 0;
+  long long sketch_max = 0;
+  for (long long i = 0; i < exact.distinct; i++) {
+    long long error = freq_get(&sketch, entries[i].key) - entries[i].count;
+    sketch_error += error;
+    if (error > sketch_max) sketch_max = error;
+  }
+
+  double heavy_error = 0;
+  long long heavy_max = 0;
+  int top = exact.distinct < TOP_WORDS ? (int)exact.distinct : TOP_WORDS;
+  for (int i = 0; i < top; i++) {
+    long long error = llabs(freq_get(&heavy, entries[i].key) - entries[i].count);
+    heavy_error += error;
+    if (error > heavy_max) heavy_max = error;
+  }
+
+  printf("\nengine,keys,memory_bytes,mean_error,max_error\n");
+  printf("freq-exact,%lld,%zu,0,0\n", exact.distinct, counter_memory(&exact));
+  printf("freq-heavy,%d,%zu,%.2f,%lld\n", top, counter_memory(&heavy),
+         top > 0 ? heavy_error / top : 0, heavy_max);
+  printf("freq-sketch,%lld,%zu,%.2f,%lld\n", exact.distinct,
+         counter_memory(&sketch),
+         exact.distinct > 0 ? sketch_error / exact.distinct : 0, sketch_max);
+
+  free(entries);
+  freq_dispose(&exact);
+  freq_dispose(&heavy);
+  freq_dispose(&sketch);
+  free(text);
+  return 0;
+}
@@ -0,0 +1,708 @@
+/*
+ * Počítání četností slov a n-gramů v tabulce s rozptýlenými položkami.
+ *
+ * Vstup se dělí na tokeny, slova nebo bajtové n-gramy, a každý token se
+ * započítá jediným průchodem seznamem synonym svého indexu: nalezená
+ * položka se zvýší a přesune na začátek seznamu, takže časté tokeny jsou
+ * nalezeny hned, chybějící položka se vloží na začátek. Index určuje
+ * rozptylovací funkce FNV-1a a počet seznamů se zdvojnásobí, kdykoli je
+ * tokenů více než seznamů, seznamy mají tedy v průměru nejvýše jednu
+ * položku a započítání trvá O(délka tokenu) nezávisle na počtu různých
+ * tokenů. Klíč se při tom
+ * nekopíruje pro každý výskyt, do tabulky se uloží jen jednou, a to
+ * společně s položkou v bloku paměti sdíleném mnoha položkami.
+ *
+ * V režimu Space-Saving se sleduje jen pevný počet tokenů v předem
+ * alokovaných slotech seřazených do min-haldy podle počtu, takže paměť
+ * nezávisí na počtu různých tokenů a v tabulce jsou jen časté tokeny.
+ * V režimu Count-Min Sketch se tokeny neukládají vůbec, počty se jen
+ * odhadují z pevného pole čítačů a tabulka zůstává prázdná.
+ *
+ * Položky mají typ ht_item_t z hashtable.h, počítadlo je ale vlastní
+ * tabulkou a s funkcemi ht_* ho nelze použít. Tabulka ht_table_t má pevně
+ * MAX_HT_SIZE seznamů, jejichž délka by rostla s počtem různých tokenů.
+ */
+
+#include "freq.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+BSTDEF(const char *, long long, freq_tree, strcmp)
+
+// Function to tell if the byte belongs to a word, bytes above 127 keep UTF-8 words whole
+bool isWordByte(unsigned char byte)
+{
+  return (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') ||
+         (byte >= '0' && byte <= '9') || byte >= 128;
+}
+
+// Function to allocate memory for one item and its key from the blocks, returns NULL if allocation fails
+void *allocateItem(freq_counter_t *counter, size_t size)
+{
+  size_t align = _Alignof(freq_item_t);
+  size = (size + align - 1) / align * align;      // the next item starts aligned too
+
+  freq_block_t *block = counter->blocks;
+  if(!block || block->size - block->used < size)
+  {
+    size_t block_size = size > FREQ_BLOCK_SIZE ? size : FREQ_BLOCK_SIZE;
+    block = malloc(sizeof(freq_block_t) + block_size);
+    if(!block) return NULL;
+
+    block->next = counter->blocks;
+    block->used = 0;
+    block->size = block_size;
+    counter->blocks = block;
+  }
+
+  void *memory = (char *)(block + 1) + block->used; // header size is a multiple of the item alignment
+  block->used += size;
+  return memory;
+}
+
+// Function to hash the key with 64-bit FNV-1a, it picks the chain and the two halves of the result give the hashes of all sketch rows
+uint64_t hashKey(const char *key)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for(; *key; key++)
+  {
+    hash ^= (unsigned char)*key;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// Function to get the chain index of the hash, the number of chains is a power of two
+size_t bucketIndex(freq_counter_t *counter, uint64_t hash)
+{
+  return (size_t)(hash ^ hash >> 32) & (counter->bucket_count - 1);
+}
+
+// Function to double the number of chains once there are more tokens than chains, the old chains stay if allocation fails
+void growBuckets(freq_counter_t *counter)
+{
+  if((size_t)counter->distinct <= counter->bucket_count) return;
+
+  size_t old_count = counter->bucket_count;
+  ht_item_t **old_buckets = counter->buckets;
+  ht_item_t **buckets = calloc(old_count * 2, sizeof(ht_item_t *));
+  if(!buckets) return;                            // longer chains are slower, but still correct
+
+  counter->buckets = buckets;
+  counter->bucket_count = old_count * 2;
+
+  for(size_t i = 0; i < old_count; i++)           // every item is relinked into its chain in the new array
+  {
+    ht_item_t *item = old_buckets[i];
+    while(item)
+    {
+      ht_item_t *next = item->next;
+      size_t index = bucketIndex(counter, hashKey(item->key));
+      item->next = buckets[index];
+      buckets[index] = item;
+      item = next;
+    }
+  }
+
+  free(old_buckets);
+}
+
+// Function to find the token in the chain of the index and move it to the front, returns NULL if it is missing
+ht_item_t *findToken(freq_counter_t *counter, size_t index)
+{
+  ht_item_t **link = &counter->buckets[index];
+  while(*link)                                    // the only probe, every token of the chain is compared once
+  {
+    if(strcmp((*link)->key, counter->token) == 0)
+    {
+      ht_item_t *found = *link;
+      *link = found->next;                        // we move the item to the front, frequent tokens stay near it
+      found->next = counter->buckets[index];
+      counter->buckets[index] = found;
+      return found;
+    }
+    link = &(*link)->next;
+  }
+  return NULL;
+}
+
+// Function to swap two slots of the heap
+void swapSlots(freq_slot_t **heap, int a, int b)
+{
+  freq_slot_t *tmp = heap[a];
+  heap[a] = heap[b];
+  heap[b] = tmp;
+  heap[a]->heap_index = a;
+  heap[b]->heap_index = b;
+}
+
+// Function to move the slot at index down the heap after its count grew
+void siftDownSlot(freq_counter_t *counter, int index)
+{
+  freq_slot_t **heap = counter->heap;
+  int used = (int)counter->distinct;
+
+  while(true)
+  {
+    int smallest = index;
+    int left = 2 * index + 1;
+    int right = left + 1;
+
+    if(left < used && heap[left]->entry.count < heap[smallest]->entry.count) smallest = left;
+    if(right < used && heap[right]->entry.count < heap[smallest]->entry.count) smallest = right;
+    if(smallest == index) return;
+
+    swapSlots(heap, index, smallest);
+    index = smallest;
+  }
+}
+
+// Function to copy the current token into the key of the slot, returns false if allocation fails
+bool setSlotKey(freq_counter_t *counter, freq_slot_t *slot)
+{
+  if(slot->key_capacity < counter->token_length + 1)
+  {
+    char *key = realloc(slot->entry.item.key, counter->token_length + 1);
+    if(!key) return false;
+
+    slot->entry.item.key = key;
+    slot->key_capacity = counter->token_length + 1;
+  }
+
+  memcpy(slot->entry.item.key, counter->token, counter->token_length + 1);
+  return true;
+}
+
+// Function to add one occurrence of the token in Space-Saving mode, returns false if allocation fails
+bool countMonitored(freq_counter_t *counter, size_t index)
+{
+  freq_slot_t *slot = (freq_slot_t *)findToken(counter, index);
+
+  if(slot)
+  {
+    slot->entry.count++;
+    slot->entry.item.value = (float)slot->entry.count;
+    siftDownSlot(counter, slot->heap_index);
+    counter->total++;
+    return true;
+  }
+
+  if(counter->distinct < counter->capacity)       // free slot, the count is exact
+  {
+    slot = &counter->slots[counter->distinct];
+    if(!setSlotKey(counter, slot)) return false;
+
+    slot->entry.count = 1;
+    slot->error = 0;
+    slot->heap_index = (int)counter->distinct;
+    counter->heap[counter->distinct++] = slot;
+
+    for(int i = slot->heap_index; i > 0 && counter->heap[(i - 1) / 2]->entry.count > 1; i = (i - 1) / 2)
+    {
+      swapSlots(counter->heap, i, (i - 1) / 2);   // the new slot has the least possible count
+    }
+  }
+  else                                            // the token takes over the slot with the least count
+  {
+    slot = counter->heap[0];
+
+    ht_item_t **link = &counter->buckets[bucketIndex(counter, hashKey(slot->entry.item.key))];
+    while(*link != &slot->entry.item)
+    {
+      link = &(*link)->next;
+    }
+
+    if(!setSlotKey(counter, slot)) return false;  // the old token stays monitored
+    *link = slot->entry.item.next;                // we unlink the old token from its chain
+
+    slot->error = slot->entry.count;              // the new token occurred at most as often as the old one
+    slot->entry.count++;
+    siftDownSlot(counter, 0);
+  }
+
+  slot->entry.item.value = (float)slot->entry.count;
+  slot->entry.item.next = counter->buckets[index];
+  counter->buckets[index] = &slot->entry.item;
+  counter->total++;
+  growBuckets(counter);                           // chains grow with the used slots, up to the capacity
+  return true;
+}
+
+// Function to get the index of the key's counter in the row, rows use hashes h1 + row * h2
+size_t sketchIndex(freq_counter_t *counter, uint64_t hash, int row)
+{
+  uint32_t first = (uint32_t)hash;
+  uint32_t second = (uint32_t)(hash >> 32) | 1;   // odd step never maps all rows to the same counter
+  return (size_t)row * counter->width + (first + (uint64_t)row * second) % counter->width;
+}
+
+// Function to estimate the count of the key as the least of its counters
+long long sketchEstimate(freq_counter_t *counter, uint64_t hash)
+{
+  long long estimate = counter->sketch[sketchIndex(counter, hash, 0)];
+  for(int row = 1; row < counter->depth; row++)
+  {
+    long long value = counter->sketch[sketchIndex(counter, hash, row)];
+    if(value < estimate) estimate = value;
+  }
+  return estimate;
+}
+
+// Function to add one occurrence of the token to the sketch with conservative update
+void countSketched(freq_counter_t *counter)
+{
+  uint64_t hash = hashKey(counter->token);
+  long long estimate = sketchEstimate(counter, hash) + 1;
+
+  for(int row = 0; row < counter->depth; row++)   // counters are raised only up to the new estimate, which keeps the error smaller
+  {
+    long long *value = &counter->sketch[sketchIndex(counter, hash, row)];
+    if(*value < estimate) *value = estimate;
+  }
+  counter->total++;
+}
+
+// Function to add one occurrence of the finished token, returns false if allocation fails
+bool countToken(freq_counter_t *counter)
+{
+  counter->token[counter->token_length] = '\0';
+
+  if(counter->sketch)                             // the sketch does not use the table at all
+  {
+    countSketched(counter);
+    return true;
+  }
+
+  size_t index = bucketIndex(counter, hashKey(counter->token));
+  if(counter->slots) return countMonitored(counter, index);
+
+  freq_item_t *found = (freq_item_t *)findToken(counter, index);
+  if(found)
+  {
+    found->count++;
+    found->item.value = (float)found->count;
+    counter->total++;
+    return true;
+  }
+
+  freq_item_t *item = allocateItem(counter, sizeof(freq_item_t) + counter->token_length + 1);
+  if(!item) return false;
+
+  item->item.key = (char *)(item + 1);            // key is interned right behind its item
+  memcpy(item->item.key, counter->token, counter->token_length + 1);
+  item->count = 1;
+  item->item.value = 1;
+  item->item.next = counter->buckets[index];
+  counter->buckets[index] = &item->item;
+
+  counter->distinct++;
+  counter->total++;
+  growBuckets(counter);
+  return true;
+}
+
+// Function to append the byte to the current token, returns false if allocation fails
+bool appendByte(freq_counter_t *counter, char byte)
+{
+  if(counter->token_length + 1 >= counter->token_capacity) // one byte stays free for the terminator
+  {
+    char *token = realloc(counter->token, counter->token_capacity * 2);
+    if(!token) return false;
+
+    counter->token = token;
+    counter->token_capacity *= 2;
+  }
+
+  counter->token[counter->token_length++] = byte;
+  return true;
+}
+
+/*
+ * Inicializace počítadla.
+ *
+ * V režimu FREQ_NGRAMS je n délka n-gramu v bajtech, v režimu FREQ_WORDS
+ * se n nepoužívá. Vrací false při neplatné délce n-gramu nebo nedostatku
+ * paměti.
+ */
+bool freq_init(freq_counter_t *counter, freq_mode_t mode, int n) {
+  counter->buckets = NULL;
+  counter->bucket_count = 0;
+  counter->mode = mode;
+  counter->n = n;
+  counter->token = NULL;
+  counter->token_length = 0;
+  counter->token_capacity = 64;
+  counter->blocks = NULL;
+  counter->slots = NULL;
+  counter->heap = NULL;
+  counter->capacity = 0;
+  counter->sketch = NULL;
+  counter->width = 0;
+  counter->depth = 0;
+  counter->distinct = 0;
+  counter->total = 0;
+
+  if(mode == FREQ_NGRAMS && n < 1) return false;
+
+  if(mode == FREQ_NGRAMS && (size_t)n >= counter->token_capacity)
+  {
+    counter->token_capacity = (size_t)n + 1;
+  }
+
+  counter->token = malloc(counter->token_capacity);
+  counter->buckets = calloc(FREQ_BUCKETS, sizeof(ht_item_t *));
+  if(!counter->token || !counter->buckets) return false;
+
+  counter->bucket_count = FREQ_BUCKETS;
+  return true;
+}
+
+/*
+ * Inicializace počítadla v režimu Space-Saving.
+ *
+ * Počítadlo sleduje nejvýše capacity tokenů a jeho paměť nezávisí na
+ * počtu různých tokenů vstupu. Token, který není sledován, převezme slot
+ * tokenu s nejmenším počtem a zdědí jeho počet jako nadhodnocení error.
+ * Každý token, který tvoří více než total / capacity všech tokenů, je
+ * zaručeně sledován, a pro sledovaný token platí
+ * count - error <= skutečný počet <= count. Funkce freq_get, freq_tree,
+ * freq_sorted a freq_top_k pracují se sledovanými tokeny a vrací horní
+ * odhad count. Vrací false při neplatných parametrech nebo nedostatku
+ * paměti.
+ */
+bool freq_init_heavy(freq_counter_t *counter, freq_mode_t mode, int n, int capacity) {
+  if(!freq_init(counter, mode, n) || capacity < 1)
+  {
+    freq_dispose(counter);
+    return false;
+  }
+
+  counter->slots = calloc(capacity, sizeof(freq_slot_t)); // keys of the slots start empty
+  counter->heap = malloc(sizeof(freq_slot_t *) * capacity);
+  counter->capacity = capacity;
+
+  if(!counter->slots || !counter->heap)
+  {
+    freq_dispose(counter);
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * Inicializace počítadla v režimu Count-Min Sketch.
+ *
+ * Počty se neukládají pro jednotlivé tokeny, ale do pevného pole
+ * ceil(e / epsilon) * ceil(ln(1 / delta)) čítačů, paměť tedy nezávisí na
+ * vstupu. Při každém výskytu se zvýší jen ty čítače tokenu, které jsou
+ * menší než nový odhad (konzervativní aktualizace). Odhad freq_get nikdy
+ * není menší než skutečný počet a s pravděpodobností alespoň 1 - delta jej
+ * převyšuje nejvýše o epsilon * total. Tokeny se neukládají, funkce
+ * freq_tree, freq_sorted a freq_top_k proto nevrací žádný token. Vrací
+ * false při neplatných parametrech nebo nedostatku paměti.
+ */
+bool freq_init_sketch(freq_counter_t *counter, freq_mode_t mode, int n, double epsilon,
+                      double delta) {
+  if(!freq_init(counter, mode, n) || !(epsilon > 0 && epsilon < 1) || !(delta > 0 && delta < 1))
+  {
+    freq_dispose(counter);
+    return false;
+  }
+
+  double width = 2.718281828459045 / epsilon;
+  if(width >= INT_MAX)
+  {
+    freq_dispose(counter);
+    return false;
+  }
+
+  counter->width = (int)width + ((int)width < width); // ceil(e / epsilon) without libm
+  for(double probability = 1; probability > delta; probability /= 2.718281828459045)
+  {
+    counter->depth++;                             // depth = ceil(ln(1 / delta))
+  }
+  counter->sketch = calloc((size_t)counter->width * counter->depth, sizeof(long long));
+
+  if(!counter->sketch)
+  {
+    freq_dispose(counter);
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * Započítání tokenů dalšího úseku vstupu.
+ *
+ * Vstup může být rozdělen na libovolné úseky, slovo nebo n-gram, který
+ * přesahuje konec úseku, pokračuje v úseku dalším. Slova se ukládají
+ * malými písmeny. N-gram nikdy neobsahuje nulový bajt, nulový bajt
+ * rozdělí vstup stejně jako konec vstupu. Vrací false při nedostatku
+ * paměti, token, který se nepodařilo uložit, se nezapočítá.
+ */
+bool freq_count(freq_counter_t *counter, const char *input, size_t length) {
+  for(size_t i = 0; i < length; i++)
+  {
+    unsigned char byte = input[i];
+
+    if(counter->mode == FREQ_WORDS)
+    {
+      if(isWordByte(byte))
+      {
+        if(byte >= 'A' && byte <= 'Z') byte += 32;  // convert to lowercase
+        if(!appendByte(counter, byte)) return false;
+      }
+      else if(counter->token_length > 0)          // the word ends here
+      {
+        bool counted = countToken(counter);
+        counter->token_length = 0;
+        if(!counted) return false;
+      }
+      continue;
+    }
+
+    if(byte == '\0')
+    {
+      counter->token_length = 0;
+      continue;
+    }
+
+    counter->token[counter->token_length++] = byte; // capacity holds n bytes and the terminator
+    if(counter->token_length == (size_t)counter->n)
+    {
+      if(!countToken(counter)) return false;
+
+      memmove(counter->token, counter->token + 1, counter->n - 1); // next n-gram overlaps in n-1 bytes
+      counter->token_length--;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Ukončení vstupu.
+ *
+ * Započítá slovo, které končí spolu se vstupem. Další volání freq_count
+ * začíná nový vstup. Vrací false při nedostatku paměti.
+ */
+bool freq_finish(freq_counter_t *counter) {
+  bool counted = true;
+
+  if(counter->mode == FREQ_WORDS && counter->token_length > 0)
+  {
+    counted = countToken(counter);
+  }
+
+  counter->token_length = 0;                      // an unfinished n-gram is not a token
+  return counted;
+}
+
+/*
+ * Počet výskytů tokenu.
+ *
+ * Vrací 0, pokud token nebyl započítán. Pořadí seznamů synonym se nemění.
+ * V režimu Count-Min Sketch vrací horní odhad počtu.
+ */
+long long freq_get(freq_counter_t *counter, const char *key) {
+  if(counter->sketch) return sketchEstimate(counter, hashKey(key));
+
+  if(!counter->buckets) return 0;
+
+  ht_item_t *item = counter->buckets[bucketIndex(counter, hashKey(key))];
+
+  while(item)
+  {
+    if(strcmp(item->key, key) == 0)
+    {
+      return ((freq_item_t *)item)->count;
+    }
+    item = item->next;
+  }
+
+  return 0;
+}
+
+/*
+ * Sestavení stromu tokenů seřazených podle klíče.
+ *
+ * Uzly stromu ukazují na internované klíče počítadla, strom proto musí
+ * být uvolněn funkcí freq_tree_dispose dříve než počítadlo. Předchozí
+ * obsah tree se nepoužívá. Vrací false při nedostatku paměti, strom pak
+ * neobsahuje všechny tokeny.
+ */
+bool freq_tree(freq_counter_t *counter, freq_tree_node_t **tree) {
+  freq_tree_init(tree);
+
+  for(size_t i = 0; i < counter->bucket_count; i++)   // hash order is unrelated to key order, so the tree stays shallow
+  {
+    for(ht_item_t *item = counter->buckets[i]; item; item = item->next)
+    {
+      freq_tree_insert(tree, item->key, ((freq_item_t *)item)->count);
+    }
+  }
+
+  return freq_tree_size(*tree) == counter->distinct;
+}
+
+// Function to get the output entry of the table item
+freq_entry_t entryOf(freq_counter_t *counter, ht_item_t *item)
+{
+  freq_entry_t entry = {item->key, ((freq_item_t *)item)->count, 0};
+  if(counter->slots)
+  {
+    entry.error = ((freq_slot_t *)item)->error;
+  }
+  return entry;
+}
+
+// Function to order the entries by count from the greatest, equal counts by key
+int compareEntries(const void *a, const void *b)
+{
+  const freq_entry_t *first = a;
+  const freq_entry_t *second = b;
+
+  if(first->count != second->count)
+  {
+    return first->count > second->count ? -1 : 1;
+  }
+  return strcmp(first->key, second->key);
+}
+
+/*
+ * Pole tokenů seřazených podle počtu výskytů.
+ *
+ * Vrací pole o counter->distinct prvcích seřazených sestupně podle počtu
+ * výskytů, tokeny se stejným počtem vzestupně podle klíče. Klíče ukazují
+ * do počítadla. Pole uvolňuje volající funkcí free. Při nedostatku paměti
+ * vrací NULL.
+ */
+freq_entry_t *freq_sorted(freq_counter_t *counter) {
+  freq_entry_t *entries = malloc(sizeof(freq_entry_t) * (counter->distinct + 1));
+  if(!entries) return NULL;
+
+  long long count = 0;
+  for(size_t i = 0; i < counter->bucket_count; i++)
+  {
+    for(ht_item_t *item = counter->buckets[i]; item; item = item->next)
+    {
+      entries[count++] = entryOf(counter, item);
+    }
+  }
+
+  qsort(entries, count, sizeof(freq_entry_t), compareEntries);
+  return entries;
+}
+
+// Function to move the entry at index down the heap, the root is the entry which ranks last
+void siftDownEntry(freq_entry_t *heap, int count, int index)
+{
+  while(true)
+  {
+    int last = index;
+    int left = 2 * index + 1;
+    int right = left + 1;
+
+    if(left < count && compareEntries(&heap[left], &heap[last]) > 0) last = left;
+    if(right < count && compareEntries(&heap[right], &heap[last]) > 0) last = right;
+    if(last == index) return;
+
+    freq_entry_t tmp = heap[index];
+    heap[index] = heap[last];
+    heap[last] = tmp;
+    index = last;
+  }
+}
+
+/*
+ * Tokeny s největšími počty výskytů.
+ *
+ * Vrací pole nejvýše k tokenů seřazených stejně jako u freq_sorted, jde
+ * tedy o jeho prvních k prvků, a jejich počet uloží do count. Tabulka se
+ * projde jednou a udržuje se jen halda k nejlepších tokenů, místo řazení
+ * všech tokenů stačí čas O(n log k). Pole uvolňuje volající funkcí free.
+ * Při nedostatku paměti vrací NULL.
+ */
+freq_entry_t *freq_top_k(freq_counter_t *counter, int k, int *count) {
+  *count = 0;
+  if(k < 0) k = 0;
+  if(k > counter->distinct) k = (int)counter->distinct;
+
+  freq_entry_t *heap = malloc(sizeof(freq_entry_t) * (k + 1));
+  if(!heap) return NULL;
+
+  for(size_t i = 0; k > 0 && i < counter->bucket_count; i++)
+  {
+    for(ht_item_t *item = counter->buckets[i]; item; item = item->next)
+    {
+      freq_entry_t entry = entryOf(counter, item);
+
+      if(*count < k)                              // heap is not full yet, we sift the entry up
+      {
+        int j = (*count)++;
+        heap[j] = entry;
+        for(; j > 0 && compareEntries(&heap[(j - 1) / 2], &heap[j]) < 0; j = (j - 1) / 2)
+        {
+          freq_entry_t tmp = heap[j];
+          heap[j] = heap[(j - 1) / 2];
+          heap[(j - 1) / 2] = tmp;
+        }
+      }
+      else if(compareEntries(&entry, &heap[0]) < 0) // entry beats the last of the top k, it replaces it
+      {
+        heap[0] = entry;
+        siftDownEntry(heap, k, 0);
+      }
+    }
+  }
+
+  for(int end = *count - 1; end > 0; end--)       // the last ranking entry moves to the end, best entries stay in front
+  {
+    freq_entry_t tmp = heap[0];
+    heap[0] = heap[end];
+    heap[end] = tmp;
+    siftDownEntry(heap, end, 0);
+  }
+
+  return heap;
+}
+
+/*
+ * Uvolnění počítadla.
+ *
+ * Uvolní všechny položky a klíče najednou, v režimu Space-Saving sloty a
+ * jejich klíče, a pole seznamů synonym.
+ */
+void freq_dispose(freq_counter_t *counter) {
+  while(counter->blocks)
+  {
+    freq_block_t *next = counter->blocks->next;
+    free(counter->blocks);
+    counter->blocks = next;
+  }
+
+  for(int i = 0; counter->slots && i < counter->capacity; i++)
+  {
+    free(counter->slots[i].entry.item.key);
+  }
+
+  free(counter->slots);
+  free(counter->heap);
+  free(counter->sketch);
+  counter->sketch = NULL;
+  free(counter->token);
+  counter->slots = NULL;
+  counter->heap = NULL;
+  counter->capacity = 0;
+  counter->token = NULL;
+  counter->token_length = 0;
+  counter->distinct = 0;
+  counter->total = 0;
+  free(counter->buckets);
+  counter->buckets = NULL;
+  counter->bucket_count = 0;
+}
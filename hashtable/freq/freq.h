@@ -0,0 +1,92 @@
+/*
+ * Hlavičkový soubor pro počítání četností slov a n-gramů v tabulce
+ * s rozptýlenými položkami.
+ */
+
+#ifndef IAL_HASHTABLE_FREQ_H
+#define IAL_HASHTABLE_FREQ_H
+
+#include "../hashtable.h"
+#include "../../btree/generic/generic.h"
+#include <stddef.h>
+
+// Velikost bloku paměti pro internované klíče
+#ifndef FREQ_BLOCK_SIZE
+#define FREQ_BLOCK_SIZE (64 * 1024)
+#endif
+
+// Počáteční počet seznamů synonym, musí být mocninou dvou
+#ifndef FREQ_BUCKETS
+#define FREQ_BUCKETS 64
+#endif
+
+// Způsob rozdělení vstupu na tokeny
+typedef enum freq_mode {
+  FREQ_WORDS,             // slova z písmen, číslic a bajtů nad 127, bez ohledu na velikost písmen
+  FREQ_NGRAMS             // všechny posloupnosti n po sobě jdoucích bajtů
+} freq_mode_t;
+
+// Položka počítadla, ukazatel na ni je zároveň ukazatelem na item
+typedef struct freq_item {
+  ht_item_t item;         // položka s internovaným klíčem, hodnota je počet převedený na float
+  long long count;        // přesný počet výskytů
+} freq_item_t;
+
+// Sledovaný token v režimu Space-Saving, ukazatel na něj je zároveň ukazatelem na entry
+typedef struct freq_slot {
+  freq_item_t entry;      // položka s horním odhadem počtu výskytů, klíč patří slotu
+  long long error;        // nejvýše o kolik je počet nadhodnocen
+  size_t key_capacity;    // velikost paměti klíče
+  int heap_index;         // pozice v haldě slotů
+} freq_slot_t;
+
+// Blok paměti, ze kterého se přidělují položky i s klíči
+typedef struct freq_block {
+  struct freq_block *next;
+  size_t used;
+  size_t size;
+} freq_block_t;
+
+// Počítadlo četností tokenů
+typedef struct freq_counter {
+  ht_item_t **buckets;    // seznamy synonym položek freq_item_t indexované hashem FNV-1a
+  size_t bucket_count;    // počet seznamů, mocnina dvou rostoucí s počtem tokenů
+  freq_mode_t mode;
+  int n;                  // délka n-gramu
+  char *token;            // rozpracovaný token, pokračuje v dalším úseku vstupu
+  size_t token_length;
+  size_t token_capacity;
+  freq_block_t *blocks;   // bloky internovaných klíčů, nejnovější první
+  freq_slot_t *slots;     // sloty režimu Space-Saving, NULL při přesném počítání
+  freq_slot_t **heap;     // min-halda slotů podle počtu
+  int capacity;           // počet slotů
+  long long *sketch;      // čítače Count-Min Sketch, depth řádků po width čítačích, NULL bez odhadu
+  int width;              // počet čítačů v řádku
+  int depth;              // počet řádků
+  long long distinct;     // počet různých tokenů, v režimu Space-Saving počet obsazených slotů, v režimu Count-Min Sketch 0
+  long long total;        // počet všech tokenů
+} freq_counter_t;
+
+// Token a jeho počet ve výstupním poli
+typedef struct freq_entry {
+  const char *key;
+  long long count;
+  long long error;        // nadhodnocení počtu, při přesném počítání 0
+} freq_entry_t;
+
+// Strom tokenů seřazených podle klíče, hodnotou je počet výskytů
+BSTDEC(const char *, long long, freq_tree)
+
+bool freq_init(freq_counter_t *counter, freq_mode_t mode, int n);
+bool freq_init_heavy(freq_counter_t *counter, freq_mode_t mode, int n, int capacity);
+bool freq_init_sketch(freq_counter_t *counter, freq_mode_t mode, int n, double epsilon,
+                      double delta);
+bool freq_count(freq_counter_t *counter, const char *input, size_t length);
+bool freq_finish(freq_counter_t *counter);
+long long freq_get(freq_counter_t *counter, const char *key);
+bool freq_tree(freq_counter_t *counter, freq_tree_node_t **tree);
+freq_entry_t *freq_sorted(freq_counter_t *counter);
+freq_entry_t *freq_top_k(freq_counter_t *counter, int k, int *count);
+void freq_dispose(freq_counter_t *counter);
+
+#endif
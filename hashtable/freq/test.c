@@ -0,0 +1,158 @@
+#include "freq.h"
+#include "../../btree/test_check.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of distinct words generated by test_many_words and test_heavy_hitters
+#define WORD_COUNT 5000
+
+// Number of slots used by test_heavy_hitters
+#define HEAVY_SLOTS 16
+
+// Checks that the keys come in increasing order, data holds the previous key and the count
+typedef struct order_check {
+  const char *previous;
+  int count;
+  bool sorted;
+} order_check_t;
+
+void check_order(freq_tree_node_t *node, void *data) {
+  order_check_t *order = data;
+  if (order->count > 0 && strcmp(node->key, order->previous) <= 0) {
+    order->sorted = false;
+  }
+  order->previous = node->key;
+  order->count++;
+}
+
+void print_node(freq_tree_node_t *node, void *data) {
+  printf("[%s,%lld]", node->key, node->value);
+}
+
+int main(int argc, char *argv[]) {
+  printf("Word and N-gram Frequency Counter - testing script\n");
+  printf("--------------------------------------------------\n\n");
+
+  printf("[test_words_in_chunks] Count words of a text split inside words\n");
+  freq_counter_t counter;
+  bool ok = freq_init(&counter, FREQ_WORDS, 0);
+  const char *chunks[] = {"The cat and th", "e dog; THE end, c", "at\xc5\xa1 cat"};
+  for (int i = 0; i < 3; i++) {
+    ok = ok && freq_count(&counter, chunks[i], strlen(chunks[i]));
+  }
+  ok = ok && freq_finish(&counter);
+  check(ok && freq_get(&counter, "the") == 3 && freq_get(&counter, "cat") == 2 &&
+            freq_get(&counter, "cat\xc5\xa1") == 1 && freq_get(&counter, "th") == 0 &&
+            counter.distinct == 6 && counter.total == 9,
+        "Words spanning chunks were counted once");
+
+  printf("[test_ordered_tree] Emit the words as a tree ordered by key\n");
+  freq_tree_node_t *tree;
+  ok = freq_tree(&counter, &tree);
+  freq_tree_for_each(tree, print_node, NULL);
+  printf("\n");
+  order_check_t order = {NULL, 0, true};
+  freq_tree_for_each(tree, check_order, &order);
+  check(ok && order.sorted && order.count == 6, "Tree holds every word in key order");
+  freq_tree_dispose(&tree);
+
+  printf("[test_sorted_array] Emit the words sorted by count\n");
+  freq_entry_t *entries = freq_sorted(&counter);
+  check(entries && strcmp(entries[0].key, "the") == 0 && entries[0].count == 3 &&
+            strcmp(entries[1].key, "cat") == 0 && strcmp(entries[2].key, "and") == 0 &&
+            strcmp(entries[5].key, "end") == 0,
+        "Greatest count is first, equal counts are ordered by key");
+
+  printf("[test_top_k] Select the 3 most frequent words\n");
+  int count;
+  freq_entry_t *top = freq_top_k(&counter, 3, &count);
+  bool same = top && count == 3;
+  for (int i = 0; same && i < count; i++) {
+    same = top[i].key == entries[i].key && top[i].count == entries[i].count &&
+           top[i].error == 0;
+  }
+  check(same, "Top 3 are the first 3 entries of the sorted array");
+  free(top);
+  free(entries);
+  freq_dispose(&counter);
+
+  printf("[test_ngrams] Count byte bigrams of \"abab\" and \"ba\\0ab\"\n");
+  ok = freq_init(&counter, FREQ_NGRAMS, 2) && freq_count(&counter, "ab", 2) &&
+       freq_count(&counter, "ab", 2) && freq_finish(&counter) &&
+       freq_count(&counter, "ba\0ab", 5) && freq_finish(&counter);
+  check(ok && freq_get(&counter, "ab") == 3 && freq_get(&counter, "ba") == 2 &&
+            counter.distinct == 2 && counter.total == 5,
+        "Bigrams overlap and do not span the end of input or a zero byte");
+  freq_dispose(&counter);
+
+  printf("[test_many_words] Count %d distinct words, each one three times\n",
+         WORD_COUNT);
+  ok = freq_init(&counter, FREQ_WORDS, 0);
+  char word[32];
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; ok && i < WORD_COUNT; i++) {
+      int length = snprintf(word, sizeof(word), "w%d ", i * 7919);
+      ok = freq_count(&counter, word, length);
+    }
+  }
+  ok = ok && freq_finish(&counter);
+  bool counted = true;
+  for (int i = 0; i < WORD_COUNT; i++) {
+    snprintf(word, sizeof(word), "w%d", i * 7919);
+    counted = counted && freq_get(&counter, word) == 3;
+  }
+  ok = ok && freq_tree(&counter, &tree);
+  check(ok && counted && counter.distinct == WORD_COUNT &&
+            freq_tree_size(tree) == WORD_COUNT && counter.bucket_count >= WORD_COUNT,
+        "Every word has count 3, the tree holds all of them and chains grew with them");
+  freq_tree_dispose(&tree);
+  freq_dispose(&counter);
+
+  printf("[test_heavy_hitters] Track %d words in %d slots, 2 of them frequent\n",
+         WORD_COUNT, HEAVY_SLOTS);
+  ok = freq_init_heavy(&counter, FREQ_WORDS, 0, HEAVY_SLOTS);
+  for (int i = 0; ok && i < WORD_COUNT; i++) {
+    int length = snprintf(word, sizeof(word), "w%d %s", i, i % 2 ? "hot " : "");
+    ok = freq_count(&counter, word, length) &&
+         (i % 5 != 0 || freq_count(&counter, "warm ", 5));
+  }
+  ok = ok && freq_finish(&counter);
+  top = ok ? freq_top_k(&counter, 2, &count) : NULL;
+  check(top && count == 2 && strcmp(top[0].key, "hot") == 0 &&
+            top[0].count - top[0].error <= WORD_COUNT / 2 &&
+            top[0].count >= WORD_COUNT / 2 && strcmp(top[1].key, "warm") == 0 &&
+            top[1].count - top[1].error <= WORD_COUNT / 5 &&
+            top[1].count >= WORD_COUNT / 5 && counter.distinct == HEAVY_SLOTS &&
+            counter.total == WORD_COUNT * 17 / 10,
+        "Frequent words are tracked and their counts bound the real ones");
+  free(top);
+  freq_dispose(&counter);
+
+  printf("[test_sketch] Estimate counts of %d words in a Count-Min Sketch\n",
+         WORD_COUNT);
+  ok = freq_init_sketch(&counter, FREQ_WORDS, 0, 0.01, 0.01);
+  for (int i = 0; ok && i < WORD_COUNT; i++) {
+    int length = snprintf(word, sizeof(word), "w%d %s", i, i % 2 ? "hot " : "");
+    ok = freq_count(&counter, word, length);
+  }
+  ok = ok && freq_finish(&counter);
+  bool bounded = true;
+  int outliers = 0;
+  for (int i = 0; i < WORD_COUNT; i++) {
+    snprintf(word, sizeof(word), "w%d", i);
+    long long estimate = freq_get(&counter, word);
+    bounded = bounded && estimate >= 1;
+    outliers += estimate - 1 > 0.01 * counter.total;
+  }
+  top = freq_top_k(&counter, 2, &count);
+  check(ok && bounded && outliers <= WORD_COUNT / 100 &&
+            freq_get(&counter, "hot") >= WORD_COUNT / 2 &&
+            freq_get(&counter, "hot") <= WORD_COUNT / 2 + 0.01 * counter.total &&
+            counter.width == 272 && counter.depth == 5 && top && count == 0,
+        "Estimates never undercount and stay within the error bound");
+  free(top);
+  freq_dispose(&counter);
+
+  return tests_summary();
+}
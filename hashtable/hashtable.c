@@ -23,7 +23,7 @@ int get_hash(char *key) {
   int result = 1;
   int length = strlen(key);
   for (int i = 0; i < length; i++) {
-    result += key[i];
+    result += (unsigned char)key[i];    // bytes above 127 would make the index negative
   }
   return (result % HT_SIZE);
 }